@@ -11,7 +11,23 @@ using namespace std;
 Actor::Actor(StudentWorld* world, const int& imageID, const double& x, const double& y,
              const double& startDirection, const double& size, const int& depth)
 : GraphObject(imageID, x, y, startDirection, size, depth), m_alive(true), m_world(world)
-{}
+{
+    m_world->actorStats().created(imageID);
+}
+
+Actor::~Actor()
+{
+    m_world->actorStats().destroyed(getImageID());
+}
+
+// Marks an Actor as dead. The world removes it once the tick is over
+void Actor::die()
+{
+    if (!m_alive)
+        return;
+    m_alive = false;
+    m_world->removeActor(this);
+}
 
 bool Actor::checkPos(const double& x, const double& y) const
 {
@@ -37,13 +53,14 @@ bool Actor::checkStatus()
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 Star::Star(StudentWorld* world, const bool& initial)
-: Actor(world, IID_STAR, VIEW_WIDTH-1, randInt(0, VIEW_HEIGHT-1), 0,
-        static_cast<double>(randInt(STAR_SIZE_MIN*100, STAR_SIZE_MAX*100)) / 100, STAR_DEPTH)
+: Actor(world, IID_STAR, VIEW_WIDTH-1, cosmeticRandInt(0, VIEW_HEIGHT-1), 0,
+        static_cast<double>(cosmeticRandInt(STAR_SIZE_MIN*100, STAR_SIZE_MAX*100)) / 100, STAR_DEPTH)
 {
+    // Stars are only scenery, so where they go comes from the cosmetic generator
     // If initial is true, place the star randomly on the screen
     // Otherwise, place it on the right side of the screen with a random y position
     if (initial)
-        moveTo(randInt(0, VIEW_WIDTH-1), getY());
+        moveTo(cosmeticRandInt(0, VIEW_WIDTH-1), getY());
 }
 
 void Star::doSomething()
@@ -82,6 +99,12 @@ DamageableObject::DamageableObject(StudentWorld* world, const int& imageID, cons
 : Actor(world, imageID, x, y, startDirection, size, depth), m_health(health)
 {}
 
+void DamageableObject::sufferDamage(const double& damage)
+{
+    m_health -= damage;
+    getWorld()->recordEvent(EVENT_DAMAGE, getImageID(), static_cast<int>(damage), getX(), getY());
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 // Blaster Implementation
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -99,8 +122,9 @@ void Blaster::doSomething()
     if (!checkStatus())
         return;
         
+    // Handle every key hit since the last tick, in the order they arrived
     int key;
-    if (getWorld()->getKey(key))
+    while (getWorld()->getKey(key))
     {
         switch(key)
         {
@@ -177,15 +201,17 @@ Alien::Alien(StudentWorld* world, const int& imageID, const double& x, const dou
 : DamageableObject(world, imageID, x, y, 0, ALIEN_SIZE, ALIEN_DEPTH, health), m_damage(damage), m_speed(speed), m_score(score), m_dy(dy), m_plan(0)
 {}
 
-void Alien::doSomething()
+template<typename Traits>
+void Alien::update()
 {
     if (getHealth() <= 0)
-        deathByPlayer();
-    if (!checkStatus())
+        deathByPlayer<Traits>();
+    if (!Actor::checkStatus()) // Qualified calls are bound statically since no Alien overrides them
         return;
     
     // Check if the alien collided with the player
-    collidedWithPlayer();
+    if (collidedWithPlayer())
+        deathByPlayer<Traits>();
     
     // Check if the alien is about to fly above or below the screen
     if (!checkPos(getX(), getY()+(m_dy*m_speed)))
@@ -205,90 +231,112 @@ void Alien::doSomething()
     getWorld()->getBlasterPos(blasterX, blasterY);
     if (blasterX < getX() && blasterY-Y_FROM_BLASTER <= getY() && getY() <= blasterY+Y_FROM_BLASTER)
     {
-        if (fire()) // If we fire a Turnip, do nothing else
+        if (Traits::fire(*this)) // If we fire a Turnip, do nothing else
             return;
-        specialAction();
+        Traits::specialAction(*this);
     }
     
     
     m_plan--;
-    moveTo(getX()-m_speed, getY()+(m_dy*m_speed));
+    GraphObject::moveTo(getX()-m_speed, getY()+(m_dy*m_speed));
     
     // Check again if the alien collided with the player
-    collidedWithPlayer();
+    if (collidedWithPlayer())
+        deathByPlayer<Traits>();
 }
 
-bool Alien::fire()
+// What happens when the alien collides with a player
+bool Alien::collidedWithPlayer()
 {
-    // Writing an equivalent probability as the one given in the spec
-    int level = getWorld()->getLevel();
-    if (randInt(1, 20 + 5 * level) <= level)
+    Blaster* blaster = getWorld()->findBlasterCollision(this);
+    if (blaster != nullptr)
     {
-        getWorld()->addActor(new Turnip(getWorld(), getX()-TURNIP_DELTA_X, getY()));
-        getWorld()->playSound(SOUND_ALIEN_SHOOT);
+        blaster->sufferDamage(m_damage);
         return true;
     }
     return false;
 }
 
-// What happens when the alien collides with a player
-void Alien::collidedWithPlayer()
-{
-    Actor* collide = getWorld()->findCollision(this);
-    if (collide != nullptr && collide->isPlayer())
-    {
-        static_cast<Blaster*>(collide)->sufferDamage(m_damage);
-        deathByPlayer();
-    }
-}
-
+template<typename Traits>
 void Alien::deathByPlayer()
 {
     getWorld()->playSound(SOUND_DEATH);
-    getWorld()->addActor(new Explosion(getWorld(), getX(), getY()));
+    if (getWorld()->showsExplosions())
+        getWorld()->addActor(new Explosion(getWorld(), getX(), getY()));
     getWorld()->increaseScore(m_score);
+    getWorld()->recordEvent(EVENT_KILL, getImageID(), m_score, getX(), getY());
     getWorld()->alienDied();
-    dropGoodie();
+    Traits::dropGoodie(*this);
     die();
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+// AlienKind Implementation
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<typename Traits>
+AlienKind<Traits>::AlienKind(StudentWorld* world)
+: Alien(world, Traits::imageID(), VIEW_WIDTH-1, randInt(0, VIEW_HEIGHT-1),
+        Traits::baseHealth()*(1+(world->getLevel()-1)*0.1), Traits::damage(), Traits::speed(),
+        Traits::startsDown() ? DOWN : randInt(DOWN, UP), Traits::score())
+{
+    if (Traits::startsDown())
+        setPlan(randInt(1, MAX_PLAN_LENGTH));
+}
+
+template<typename Traits>
+void AlienKind<Traits>::updateBatch(const std::vector<Actor*>& batch)
+{
+    for (Actor* actor : batch)
+        static_cast<AlienKind*>(actor)->template update<Traits>();
+}
+
+template class AlienKind<SmallgonTraits>;
+template class AlienKind<SmoregonTraits>;
+template class AlienKind<SnagglegonTraits>;
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 // Smallgon Implementation
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
-Smallgon::Smallgon(StudentWorld* world)
-: Alien(world, IID_SMALLGON, VIEW_WIDTH-1, randInt(0, VIEW_HEIGHT-1), 5*(1+(world->getLevel()-1)*0.1),
-        SMALLGON_DAMAGE, SMALLGON_SPEED, randInt(DOWN, UP), SMALLGON_SCORE)
-{}
+bool SmallgonTraits::fire(Alien& alien)
+{
+    // Writing an equivalent probability as the one given in the spec
+    StudentWorld* world = alien.getWorld();
+    int level = world->getLevel();
+    if (randInt(1, 20 + 5 * level) <= level)
+    {
+        world->addActor(new Turnip(world, alien.getX()-TURNIP_DELTA_X, alien.getY()));
+        world->playSound(SOUND_ALIEN_SHOOT);
+        return true;
+    }
+    return false;
+}
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
 // Smoregon Implementation
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
-Smoregon::Smoregon(StudentWorld* world)
-: Alien(world, IID_SMOREGON, VIEW_WIDTH-1, randInt(0, VIEW_HEIGHT-1), 5*(1+(world->getLevel()-1)*0.1),
-        SMOREGON_DAMAGE, SMOREGON_SPEED, randInt(DOWN, UP), SMOREGON_SCORE)
-{}
-
-void Smoregon::specialAction()
+void SmoregonTraits::specialAction(Alien& alien)
 {
-    int level = getWorld()->getLevel();
+    int level = alien.getWorld()->getLevel();
     if (randInt(1, 20 + 5 * level) <= level)
     {
-        setDeltaY(0);
-        setPlan(VIEW_WIDTH);
-        setSpeed(SMOREGON_RAM_SPEED);
+        alien.setDeltaY(0);
+        alien.setPlan(VIEW_WIDTH);
+        alien.setSpeed(SMOREGON_RAM_SPEED);
     }
 }
 
-void Smoregon::dropGoodie()
+void SmoregonTraits::dropGoodie(Alien& alien)
 {
+    StudentWorld* world = alien.getWorld();
     if (randInt(1, 3) == 1)
     {
         if (randInt(1, 2) == 1)
-            getWorld()->addActor(new RepairGoodie(getWorld(), getX(), getY()));
+            world->addActor(new RepairGoodie(world, alien.getX(), alien.getY()));
         else
-            getWorld()->addActor(new TorpedoGoodie(getWorld(), getX(), getY()));
+            world->addActor(new TorpedoGoodie(world, alien.getX(), alien.getY()));
     }
 }
 
@@ -296,27 +344,22 @@ void Smoregon::dropGoodie()
 // Snagglegon Implementation
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
-Snagglegon::Snagglegon(StudentWorld* world)
-: Alien(world, IID_SNAGGLEGON, VIEW_WIDTH-1, randInt(0, VIEW_HEIGHT-1), 10*(1+(world->getLevel()-1)*0.1),
-        SNAGGLEGON_DAMAGE, SNAGGLEGON_SPEED, DOWN, SNAGGLEGON_SCORE)
-{
-    setPlan(randInt(1, MAX_PLAN_LENGTH)); // The Snagglegon moves down and left initially
-}
-
-void Snagglegon::dropGoodie()
+void SnagglegonTraits::dropGoodie(Alien& alien)
 {
+    StudentWorld* world = alien.getWorld();
     if (randInt(1, 6) == 1)
-        getWorld()->addActor(new ExtraLifeGoodie(getWorld(), getX(), getY()));
+        world->addActor(new ExtraLifeGoodie(world, alien.getX(), alien.getY()));
 }
 
-bool Snagglegon::fire()
+bool SnagglegonTraits::fire(Alien& alien)
 {
     // Writing an equivalent probability as the one given in the spec
-    int level = getWorld()->getLevel();
+    StudentWorld* world = alien.getWorld();
+    int level = world->getLevel();
     if (randInt(1, 15 + 5 * level) <= level)
     {
-        getWorld()->addActor(new Torpedo(getWorld(), getX()-TURNIP_DELTA_X, getY(), SHOT_BY_ALIEN));
-        getWorld()->playSound(SOUND_TORPEDO);
+        world->addActor(new Torpedo(world, alien.getX()-TURNIP_DELTA_X, alien.getY(), SHOT_BY_ALIEN));
+        world->playSound(SOUND_TORPEDO);
         return true;
     }
     return false;
@@ -330,27 +373,23 @@ Projectile::Projectile(StudentWorld* world, const int& imageID, const double& x,
                        const double& damage, const double& velocity, const double& rotation, const int& shotBy)
 : Actor(world, imageID, x, y, shotBy * 180, PROJECTILE_SIZE, PROJECTILE_DEPTH), m_damage(damage),
         m_velocity(velocity), m_rotation(rotation), m_shotBy(shotBy)
-{}
+{
+    world->recordEvent(EVENT_SHOT, imageID, shotBy, x, y);
+}
 
-void Projectile::collision(const int& shotBy)
+// Checks everything the Projectile swept through on its way from (fromX, fromY) to where it is now
+void Projectile::collision(const int& shotBy, const double& fromX, const double& fromY)
 {
-    DamageableObject* collide = static_cast<DamageableObject*>(getWorld()->findCollision(this));
-    bool predicate;
-    if (collide != nullptr && !collide->isProjectile())
-    {
-        if (shotBy == SHOT_BY_ALIEN)
-            predicate = !collide->isAlien();
-        else
-            predicate = collide->isAlien();
-    }
-    else return;
+    // Only look at the layer this Projectile can hit, so other Projectiles and Goodies can't get in
+    // the way, and whatever is found is always a DamageableObject
+    int target = (shotBy == SHOT_BY_PLAYER) ? LAYER_ALIENS : LAYER_PLAYER;
+    DamageableObject* collide = static_cast<DamageableObject*>(getWorld()->findSweptCollision(this, fromX, fromY, target));
+    if (collide == nullptr)
+        return;
     
-    if (predicate)
-    {
-        collide->sufferDamage(getDamage());
-        getWorld()->playSound(SOUND_BLAST);
-        die();
-    }
+    collide->sufferDamage(getDamage());
+    getWorld()->playSound(SOUND_BLAST);
+    die();
 }
 
 void Projectile::move()
@@ -361,9 +400,11 @@ void Projectile::move()
                        
 void Projectile::cycle(const double& pixels, const int& shotBy, const bool& rotate)
 {
-    collision(shotBy);
+    // One query covers the whole move, so nothing is skipped over however far it goes in a tick
+    double fromX = getX();
+    double fromY = getY();
     move();
-    collision(shotBy);
+    collision(shotBy, fromX, fromY);
 }
 
 void Projectile::doSomething()
@@ -428,12 +469,13 @@ void Goodie::doSomething()
 
 bool Goodie::collision()
 {
-    Actor* collide = getWorld()->findCollision(this);
-    if (collide != nullptr && collide->isPlayer())
+    Blaster* blaster = getWorld()->findBlasterCollision(this);
+    if (blaster != nullptr)
     {
-        static_cast<Blaster*>(collide)->gotGoodie(m_goodieType);
+        blaster->gotGoodie(m_goodieType);
         getWorld()->playSound(SOUND_GOODIE);
         getWorld()->increaseScore(GOODIE_SCORE);
+        getWorld()->recordEvent(EVENT_GOODIE, getImageID(), GOODIE_SCORE, getX(), getY());
         die();
         return true;
     }
@@ -2,6 +2,9 @@
 #define ACTOR_H_
 
 #include "GraphObject.h"
+#include "ActorHandle.h"
+#include "ActorPool.h"
+#include <vector>
 
 class StudentWorld;
 
@@ -21,6 +24,14 @@ const int GOODIE_EXTRA_LIFE = 0; // Used to identify the types of Goodies
 const int GOODIE_REPAIR     = 1;
 const int GOODIE_TORPEDO    = 2;
 
+const int LAYER_NONE         = 0;      // Collision layers. Every collidable Actor is on exactly one,
+const int LAYER_PLAYER       = 1 << 0; // and collision queries take a mask of the layers to look in
+const int LAYER_PLAYER_SHOTS = 1 << 1;
+const int LAYER_ALIEN_SHOTS  = 1 << 2;
+const int LAYER_ALIENS       = 1 << 3;
+const int LAYER_GOODIES      = 1 << 4;
+const int LAYER_ALL          = (1 << 5) - 1;
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 // Actor Declaration
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -30,11 +41,18 @@ class Actor : public GraphObject
 public:
     Actor(StudentWorld* world, const int& imageID, const double& x, const double& y, const double& startDirection = 0,
           const double& size = 1.0, const int& depth = 0);
+    virtual ~Actor();
+    
+        // Memory comes from (and goes back to) ActorPool, so a steady stream of spawns and deaths
+        // doesn't touch the heap
+    static void* operator new(std::size_t size)             { return ActorPool::allocate(size); }
+    static void  operator delete(void* p, std::size_t size) { ActorPool::release(p, size); }
     
         // Accessors
-    bool isAlive() { return m_alive; }
+    bool isAlive() const { return m_alive; }
     bool checkPos(const double& x, const double& y) const;
-    virtual bool isCollidable() const { return true; }
+    virtual int  getLayer()     const { return LAYER_NONE; }
+    bool isCollidable()         const { return getLayer() != LAYER_NONE; }
     virtual bool isAlien()      const { return false; }
     virtual bool isPlayer()     const { return false; }
     virtual bool isProjectile() const { return false; }
@@ -43,11 +61,17 @@ public:
         // Actions
     virtual void doSomething() = 0;
     virtual bool checkStatus();
-    void die() { m_alive = false; }
+    void die();
+    
+        // How other code can refer to the Actor without holding onto a pointer. Only StudentWorld
+        // should set this, once the Actor is stored
+    ActorHandle getHandle() const { return m_handle; }
+    void setHandle(const ActorHandle& handle) { m_handle = handle; }
     
 private:
     bool m_alive;
     StudentWorld* m_world;
+    ActorHandle m_handle;
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -65,9 +89,6 @@ class Star : public Actor
 public:
     Star(StudentWorld* world, const bool& initial = false);
     
-        // Accessors
-    virtual bool isCollidable() const { return false; }
-    
         // Actions
     virtual void doSomething();
 };
@@ -86,9 +107,6 @@ class Explosion : public Actor
 public:
     Explosion(StudentWorld* world, const double& x, const double& y);
     
-        // Accessors
-    virtual bool isCollidable() const { return false; }
-    
         // Actions
     virtual void doSomething();
     
@@ -110,7 +128,7 @@ public:
     double getHealth() const { return m_health; }
     
         // Mutators
-    void sufferDamage(const double& damage)          { m_health -= damage; }
+    void sufferDamage(const double& damage);
     virtual void restoreHealth(const double& health) { m_health += health; }
     
 private:
@@ -145,6 +163,7 @@ public:
     double getEnergy()      const { return m_energy; }
     double getTorpedoes()   const { return m_torpedoes; }
     virtual bool isPlayer() const { return true; }
+    virtual int  getLayer() const { return LAYER_PLAYER; }
     
         // Actions
     virtual void doSomething();
@@ -179,6 +198,10 @@ public:
     
         // Accessors
     virtual bool isAlien() const { return true; }
+    virtual int  getLayer() const { return LAYER_ALIENS; }
+    double getSpeed()  const { return m_speed; }
+    int    getDeltaY() const { return m_dy; }
+    int    getPlan()   const { return m_plan; }
     
         // Mutators
     void setSpeed(const double& speed) { m_speed = speed; }
@@ -186,14 +209,15 @@ public:
     void setPlan(const double& plan)   { m_plan = plan; }
     
         // Actions
-    virtual void doSomething();
-    virtual void specialAction() {};
-    virtual void dropGoodie() = 0;
-    virtual bool fire();
+        // The behavior of each kind of Alien is described by a traits type (see below), so a tick
+        // is a template that is resolved at compile time instead of a chain of virtual calls
+    template<typename Traits>
+    void update();
     
 private:
+    template<typename Traits>
     void deathByPlayer();
-    void collidedWithPlayer();
+    bool collidedWithPlayer();
     
     double m_damage;
     double m_speed;
@@ -203,59 +227,99 @@ private:
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
-// Smallgon Declaration
+// AlienKind Declaration
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
-const double SMALLGON_DAMAGE = 5;   // Damage to the Blaster when colliding into it
-const double SMALLGON_SPEED  = 2.0;
-const int    SMALLGON_SCORE  = 250;
+// A traits type supplies the constants of a kind of Alien as constexpr functions, along with
+// fire(), specialAction(), and dropGoodie(), which are called statically from Alien::update()
 
-class Smallgon : public Alien
+template<typename Traits>
+class AlienKind : public Alien
 {
 public:
-    Smallgon(StudentWorld* world);
+    AlienKind(StudentWorld* world);
     
         // Actions
-    virtual void dropGoodie() {};
+    virtual void doSomething() final { update<Traits>(); }
+    
+        // Updates a whole batch of one kind of Alien with no virtual dispatch. Every Actor in
+        // the batch must be of this kind
+    static void updateBatch(const std::vector<Actor*>& batch);
 };
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Smallgon Declaration
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+constexpr double SMALLGON_DAMAGE = 5;   // Damage to the Blaster when colliding into it
+constexpr double SMALLGON_SPEED  = 2.0;
+constexpr int    SMALLGON_SCORE  = 250;
+
+struct SmallgonTraits
+{
+    static constexpr int    imageID()    { return IID_SMALLGON; }
+    static constexpr double baseHealth() { return 5; }
+    static constexpr double damage()     { return SMALLGON_DAMAGE; }
+    static constexpr double speed()      { return SMALLGON_SPEED; }
+    static constexpr int    score()      { return SMALLGON_SCORE; }
+    static constexpr bool   startsDown() { return false; }
+    
+    static bool fire(Alien& alien);
+    static void specialAction(Alien&) {}
+    static void dropGoodie(Alien&)    {}
+};
+
+using Smallgon = AlienKind<SmallgonTraits>;
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 // Smoregon Declaration
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
-const double SMOREGON_DAMAGE    = 5;   // Damage to the Blaster when colliding into it
-const double SMOREGON_SPEED     = 2.0;
-const double SMOREGON_RAM_SPEED = 5.0;
-const int    SMOREGON_SCORE     = 250;
+constexpr double SMOREGON_DAMAGE    = 5;   // Damage to the Blaster when colliding into it
+constexpr double SMOREGON_SPEED     = 2.0;
+constexpr double SMOREGON_RAM_SPEED = 5.0;
+constexpr int    SMOREGON_SCORE     = 250;
 
-class Smoregon : public Alien
+struct SmoregonTraits
 {
-public:
-    Smoregon(StudentWorld* world);
+    static constexpr int    imageID()    { return IID_SMOREGON; }
+    static constexpr double baseHealth() { return 5; }
+    static constexpr double damage()     { return SMOREGON_DAMAGE; }
+    static constexpr double speed()      { return SMOREGON_SPEED; }
+    static constexpr int    score()      { return SMOREGON_SCORE; }
+    static constexpr bool   startsDown() { return false; }
     
-    // Actions
-    virtual void dropGoodie();
-    virtual void specialAction();
+    static bool fire(Alien& alien) { return SmallgonTraits::fire(alien); }
+    static void specialAction(Alien& alien);
+    static void dropGoodie(Alien& alien);
 };
 
+using Smoregon = AlienKind<SmoregonTraits>;
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 // Snagglegon Declaration
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
-const double SNAGGLEGON_DAMAGE = 15;   // Damage to the Blaster when colliding into it
-const double SNAGGLEGON_SPEED  = 1.75;
-const int    SNAGGLEGON_SCORE  = 1000;
+constexpr double SNAGGLEGON_DAMAGE = 15;   // Damage to the Blaster when colliding into it
+constexpr double SNAGGLEGON_SPEED  = 1.75;
+constexpr int    SNAGGLEGON_SCORE  = 1000;
 
-class Snagglegon : public Alien
+struct SnagglegonTraits
 {
-public:
-    Snagglegon(StudentWorld* world);
+    static constexpr int    imageID()    { return IID_SNAGGLEGON; }
+    static constexpr double baseHealth() { return 10; }
+    static constexpr double damage()     { return SNAGGLEGON_DAMAGE; }
+    static constexpr double speed()      { return SNAGGLEGON_SPEED; }
+    static constexpr int    score()      { return SNAGGLEGON_SCORE; }
+    static constexpr bool   startsDown() { return true; } // The Snagglegon moves down and left initially
     
-        // Actions
-    virtual void dropGoodie();
-    virtual bool fire();
+    static bool fire(Alien& alien);
+    static void specialAction(Alien&) {}
+    static void dropGoodie(Alien& alien);
 };
 
+using Snagglegon = AlienKind<SnagglegonTraits>;
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 // Projectile Declaration
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -272,6 +336,7 @@ public:
         // Accessors
     double getDamage() const { return m_damage; }
     virtual bool isProjectile() const { return true; }
+    virtual int  getLayer()     const { return m_shotBy == SHOT_BY_PLAYER ? LAYER_PLAYER_SHOTS : LAYER_ALIEN_SHOTS; }
     int shotBy() const { return m_shotBy; }
     
         // Actions
@@ -280,7 +345,7 @@ public:
     void setVelocity(const double& velocity) { m_velocity = velocity; }
     
 private:
-    virtual void collision(const int& shotBy);
+    virtual void collision(const int& shotBy, const double& fromX, const double& fromY);
     virtual void move();
     
     double m_damage;
@@ -347,6 +412,9 @@ class Goodie : public Actor
 public:
     Goodie(StudentWorld* world, const int& imageID, const double& x, const double& y, const int& goodieType);
     
+        // Accessors
+    virtual int getLayer() const { return LAYER_GOODIES; }
+    
         // Actions
     virtual void doSomething();
     
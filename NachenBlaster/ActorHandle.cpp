@@ -0,0 +1,72 @@
+#include "ActorHandle.h"
+#include <cassert>
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// SlotMap Implementation
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+SlotMap::SlotMap()
+: m_firstFree(-1), m_size(0)
+{}
+
+ActorHandle SlotMap::insert(const int& group, const int& slot)
+{
+    // Reuse a freed entry if there is one. Its generation was already bumped when it was freed
+    int index = m_firstFree;
+    if (index >= 0)
+        m_firstFree = m_entries[index].nextFree;
+    else
+    {
+        index = static_cast<int>(m_entries.size());
+        assert(static_cast<uint32_t>(index) <= HANDLE_INDEX_MASK);
+        m_entries.push_back(Entry{ Location{ -1, -1 }, 1, -1, false });
+    }
+    
+    Entry& e = m_entries[index];
+    e.location = Location{ group, slot };
+    e.inUse = true;
+    m_size++;
+    return ActorHandle(index, e.generation);
+}
+
+void SlotMap::erase(const ActorHandle& handle)
+{
+    if (find(handle) == nullptr)
+        return;
+    Entry& e = m_entries[handle.index()];
+    e.inUse = false;
+    
+    // Generation 0 is skipped so that the null handle can never match a live entry
+    e.generation = (e.generation == HANDLE_MAX_GENERATION) ? 1 : e.generation + 1;
+    e.nextFree = m_firstFree;
+    m_firstFree = handle.index();
+    m_size--;
+}
+
+void SlotMap::move(const ActorHandle& handle, const int& group, const int& slot)
+{
+    assert(find(handle) != nullptr);
+    m_entries[handle.index()].location = Location{ group, slot };
+}
+
+// Frees every entry without forgetting the generations, so handles that outlive a level are
+// still recognized as stale in the next one
+void SlotMap::clear()
+{
+    for (uint32_t i = 0; i < m_entries.size(); i++)
+    {
+        if (m_entries[i].inUse)
+            erase(ActorHandle(i, m_entries[i].generation));
+    }
+}
+
+const SlotMap::Location* SlotMap::find(const ActorHandle& handle) const
+{
+    if (handle.index() >= m_entries.size())
+        return nullptr;
+    const Entry& e = m_entries[handle.index()];
+    if (!e.inUse || e.generation != handle.generation())
+        return nullptr;
+    return &e.location;
+}
@@ -0,0 +1,79 @@
+#ifndef ACTORHANDLE_H_
+#define ACTORHANDLE_H_
+
+#include <cstdint>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// ActorHandle Declaration
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+// A reference to an Actor that knows when the Actor is gone. The low HANDLE_INDEX_BITS pick an entry
+// in the world's SlotMap, and the rest are that entry's generation, which changes every time the
+// entry is reused, so an old handle never resolves to whatever Actor took its place
+const int      HANDLE_INDEX_BITS      = 20;
+const uint32_t HANDLE_INDEX_MASK      = (1u << HANDLE_INDEX_BITS) - 1;
+const uint32_t HANDLE_MAX_GENERATION  = (1u << (32 - HANDLE_INDEX_BITS)) - 1;
+
+class ActorHandle
+{
+public:
+    ActorHandle() : m_value(0) {} // The null handle, which never resolves to anything
+    ActorHandle(const uint32_t& index, const uint32_t& generation)
+    : m_value((generation << HANDLE_INDEX_BITS) | index) {}
+    
+        // Accessors
+    uint32_t index()      const { return m_value & HANDLE_INDEX_MASK; }
+    uint32_t generation() const { return m_value >> HANDLE_INDEX_BITS; }
+    bool     isNull()     const { return m_value == 0; }
+    uint32_t value()      const { return m_value; }
+    
+    bool operator==(const ActorHandle& other) const { return m_value == other.m_value; }
+    bool operator!=(const ActorHandle& other) const { return m_value != other.m_value; }
+    
+private:
+    uint32_t m_value;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// SlotMap Declaration
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Maps handles to where their Actors are stored: a group and a slot within it. Storage can move an
+// Actor around freely as long as it calls move() afterwards; every handle to it stays valid
+class SlotMap
+{
+public:
+    struct Location
+    {
+        int group;
+        int slot;
+    };
+    
+    SlotMap();
+    
+    ActorHandle insert(const int& group, const int& slot);
+    void erase(const ActorHandle& handle);
+    void move(const ActorHandle& handle, const int& group, const int& slot);
+    void clear();
+    void reserve(const int& entries) { m_entries.reserve(entries); }
+    
+        // Accessors
+    const Location* find(const ActorHandle& handle) const; // nullptr if the handle is stale or null
+    int size() const { return m_size; }
+    
+private:
+    struct Entry
+    {
+        Location location;
+        uint32_t generation;
+        int      nextFree;   // Only meaningful while the entry is on the free list
+        bool     inUse;
+    };
+    
+    std::vector<Entry> m_entries;
+    int m_firstFree;
+    int m_size;
+};
+
+#endif // ACTORHANDLE_H_
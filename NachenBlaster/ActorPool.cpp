@@ -0,0 +1,102 @@
+#include "ActorPool.h"
+#include <new>
+using namespace std;
+
+// Which free list a block of this size belongs on, or -1 if it's too big to pool
+static int sizeClass(const size_t& size)
+{
+    if (size == 0 || size > POOL_MAX_BLOCK)
+        return -1;
+    return static_cast<int>((size - 1) / POOL_GRANULE);
+}
+
+struct FreeBlock
+{
+    FreeBlock* next;
+};
+
+// Plain arrays, so getting at them is just a thread-local address. A thread_local with a destructor
+// would be checked for construction on every allocation
+static thread_local FreeBlock* t_heads[POOL_SIZE_CLASSES];
+static thread_local int        t_counts[POOL_SIZE_CLASSES];
+
+// Hands the calling thread's free blocks back to the heap when it exits. Blocks are allocated one
+// at a time, so any of them can go back on its own
+struct FreeListReleaser
+{
+    ~FreeListReleaser()
+    {
+        for (int k = 0; k < POOL_SIZE_CLASSES; k++)
+        {
+            while (t_heads[k] != nullptr)
+            {
+                FreeBlock* block = t_heads[k];
+                t_heads[k] = block->next;
+                ::operator delete(block);
+            }
+            t_counts[k] = 0;
+        }
+    }
+};
+
+// Signs the calling thread up to release its free blocks when it exits. Called whenever a list goes
+// from empty to not, which is rare enough that the check for construction doesn't matter there
+static void releaseOnExit()
+{
+    thread_local FreeListReleaser releaser;
+    (void)releaser;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// ActorPool Implementation
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+void* ActorPool::allocate(const size_t& size)
+{
+    int k = sizeClass(size);
+    if (k < 0)
+        return ::operator new(size);
+    
+    FreeBlock* block = t_heads[k];
+    if (block == nullptr)
+        return ::operator new((k + 1) * POOL_GRANULE);
+    t_heads[k] = block->next;
+    t_counts[k]--;
+    return block;
+}
+
+void ActorPool::release(void* block, const size_t& size)
+{
+    if (block == nullptr)
+        return;
+    int k = sizeClass(size);
+    if (k < 0)
+    {
+        ::operator delete(block);
+        return;
+    }
+    
+    if (t_heads[k] == nullptr)
+        releaseOnExit();
+    FreeBlock* freed = static_cast<FreeBlock*>(block);
+    freed->next = t_heads[k];
+    t_heads[k] = freed;
+    t_counts[k]++;
+}
+
+void ActorPool::reserve(const Reservation* reservations, const int& n)
+{
+    int wanted[POOL_SIZE_CLASSES] = {};
+    for (int i = 0; i < n; i++)
+    {
+        int k = sizeClass(reservations[i].size);
+        if (k >= 0)
+            wanted[k] += reservations[i].count;
+    }
+    
+    for (int k = 0; k < POOL_SIZE_CLASSES; k++)
+    {
+        while (t_counts[k] < wanted[k])
+            release(::operator new((k + 1) * POOL_GRANULE), (k + 1) * POOL_GRANULE);
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef ACTORPOOL_H_
+#define ACTORPOOL_H_
+
+#include <cstddef>
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Manifest Constants
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+const std::size_t POOL_GRANULE      = 16;  // Block sizes are rounded up to a multiple of this
+const std::size_t POOL_MAX_BLOCK    = 256; // Anything bigger goes straight to the heap
+const int         POOL_SIZE_CLASSES = POOL_MAX_BLOCK / POOL_GRANULE;
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// ActorPool Declaration
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Where Actors get their memory. Every Actor that dies hands its block to a free list for its
+// size, and the next Actor of that size reuses it, so once a game has had as many of each kind of
+// Actor alive at once as it ever will, spawning never touches the heap again.
+//
+// Each thread has free lists of its own, so worlds running on different threads (see BatchEnv)
+// never contend for them. A block can be released on a different thread than the one that
+// allocated it; it just joins that thread's lists.
+class ActorPool
+{
+public:
+    struct Reservation
+    {
+        std::size_t size;
+        int         count;
+    };
+    
+    static void* allocate(const std::size_t& size);
+    static void  release(void* block, const std::size_t& size);
+    
+        // Makes sure the calling thread's free lists could hand out every reserved block without
+        // going to the heap. Reservations whose sizes share a list add up
+    static void  reserve(const Reservation* reservations, const int& n);
+};
+
+#endif // ACTORPOOL_H_
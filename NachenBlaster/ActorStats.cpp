@@ -0,0 +1,147 @@
+#include "ActorStats.h"
+#include "Actor.h"
+#include "GraphObject.h"
+#include <iostream>
+#include <iomanip>
+using namespace std;
+
+ActorStats::ActorStats()
+: m_types(), m_ticks(0)
+{
+    struct TypeInfo
+    {
+        int imageID;
+        const char* name;
+        size_t size;
+    };
+    
+    const TypeInfo types[] = {
+        { IID_NACHENBLASTER,  "Blaster",         sizeof(Blaster) },
+        { IID_SMALLGON,       "Smallgon",        sizeof(Smallgon) },
+        { IID_SMOREGON,       "Smoregon",        sizeof(Smoregon) },
+        { IID_SNAGGLEGON,     "Snagglegon",      sizeof(Snagglegon) },
+        { IID_REPAIR_GOODIE,  "RepairGoodie",    sizeof(RepairGoodie) },
+        { IID_LIFE_GOODIE,    "ExtraLifeGoodie", sizeof(ExtraLifeGoodie) },
+        { IID_TORPEDO_GOODIE, "TorpedoGoodie",   sizeof(TorpedoGoodie) },
+        { IID_TORPEDO,        "Torpedo",         sizeof(Torpedo) },
+        { IID_TURNIP,         "Turnip",          sizeof(Turnip) },
+        { IID_CABBAGE,        "Cabbage",         sizeof(Cabbage) },
+        { IID_STAR,           "Star",            sizeof(Star) },
+        { IID_EXPLOSION,      "Explosion",       sizeof(Explosion) },
+    };
+    
+    for (const TypeInfo& t : types)
+    {
+        m_types[t.imageID].name = t.name;
+        m_types[t.imageID].bytesPerObject = (t.size + POOL_GRANULE - 1) / POOL_GRANULE * POOL_GRANULE;
+    }
+}
+
+void ActorStats::created(const int& imageID)
+{
+    ActorTypeStats& t = m_types[imageID];
+    t.live++;
+    t.created++;
+    t.createdThisTick++;
+    if (t.live > t.peakLive)
+        t.peakLive = t.live;
+}
+
+void ActorStats::destroyed(const int& imageID)
+{
+    m_types[imageID].live--;
+}
+
+void ActorStats::endTick()
+{
+    for (ActorTypeStats& t : m_types)
+    {
+        if (t.createdThisTick > t.peakCreatedPerTick)
+            t.peakCreatedPerTick = t.createdThisTick;
+        t.createdThisTick = 0;
+    }
+    m_ticks++;
+}
+
+long ActorStats::totalLive() const
+{
+    long total = 0;
+    for (const ActorTypeStats& t : m_types)
+        total += t.live;
+    return total;
+}
+
+size_t ActorStats::totalLiveBytes() const
+{
+    size_t total = 0;
+    for (const ActorTypeStats& t : m_types)
+        total += t.liveBytes();
+    return total;
+}
+
+// Prints a table of every type, with the average and peak number created per tick
+void ActorStats::dump(ostream& out) const
+{
+    ios::fmtflags flags = out.flags();
+    streamsize precision = out.precision();
+    out << left  << setw(16) << "Type"
+        << right << setw(6)  << "Bytes" << setw(7) << "Live" << setw(7) << "Peak"
+                 << setw(9)  << "Created" << setw(9) << "Avg/tick" << setw(9) << "Max/tick" << endl;
+    for (const ActorTypeStats& t : m_types)
+    {
+        double perTick = m_ticks == 0 ? 0 : static_cast<double>(t.created) / m_ticks;
+        out << left  << setw(16) << t.name
+            << right << setw(6)  << t.bytesPerObject << setw(7) << t.live << setw(7) << t.peakLive
+                     << setw(9)  << t.created << setw(9) << fixed << setprecision(2) << perTick
+                     << setw(9)  << t.peakCreatedPerTick << endl;
+    }
+    out << totalLive() << " live Actors using " << totalLiveBytes() << " bytes after " << m_ticks << " ticks" << endl;
+    out.flags(flags);
+    out.precision(precision);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// TickStats Implementation
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+TickStats::TickStats()
+: m_timed(false), m_phases(0), m_queries(0), m_candidates(0)
+{}
+
+void TickStats::begin(const bool& timed)
+{
+    m_timed = timed;
+    m_phases = 0;
+    m_queries = 0;
+    m_candidates = 0;
+    if (m_timed)
+        m_phaseStart = Clock::now();
+}
+
+void TickStats::endPhase(const char* name)
+{
+    if (!m_timed || m_phases == MAX_TICK_PHASES)
+        return;
+    Clock::time_point now = Clock::now();
+    m_phaseNames[m_phases] = name;
+    m_phaseMs[m_phases] = chrono::duration<double, milli>(now - m_phaseStart).count();
+    m_phases++;
+    m_phaseStart = now;
+}
+
+void TickStats::dump(ostream& out) const
+{
+    ios::fmtflags flags = out.flags();
+    streamsize precision = out.precision();
+    out << fixed << setprecision(3);
+    if (m_phases > 0)
+    {
+        out << "  phases (ms):";
+        for (int i = 0; i < m_phases; i++)
+            out << " " << m_phaseNames[i] << " " << m_phaseMs[i];
+        out << endl;
+    }
+    out << "  collision queries: " << m_queries << ", looking at " << m_candidates << " Actors" << endl;
+    out.flags(flags);
+    out.precision(precision);
+}
@@ -0,0 +1,89 @@
+#ifndef ACTORSTATS_H_
+#define ACTORSTATS_H_
+
+#include "GameConstants.h"
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Actor Accounting
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Every concrete Actor type has an image of its own, so image IDs double as type IDs
+const int NUM_ACTOR_TYPES = IID_EXPLOSION + 1;
+
+struct ActorTypeStats
+{
+    const char* name;
+    std::size_t bytesPerObject;  // The size of the object's block in ActorPool
+    long live;
+    long peakLive;
+    long created;                // Over the world's whole life
+    long createdThisTick;
+    long peakCreatedPerTick;
+    
+    std::size_t liveBytes() const { return live * bytesPerObject; }
+};
+
+class ActorStats
+{
+public:
+    ActorStats();
+    
+        // Called by every Actor's constructor and destructor
+    void created(const int& imageID);
+    void destroyed(const int& imageID);
+    
+        // Called by the world after each tick
+    void endTick();
+    
+        // Accessors
+    const ActorTypeStats& get(const int& imageID) const { return m_types[imageID]; }
+    long ticks() const { return m_ticks; }
+    long totalLive() const;
+    std::size_t totalLiveBytes() const;
+    
+    void dump(std::ostream& out) const;
+    
+private:
+    ActorTypeStats m_types[NUM_ACTOR_TYPES];
+    long m_ticks;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Tick Accounting
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+const int MAX_TICK_PHASES = 8;
+
+// Where the current tick's time went, phase by phase, and how much collision checking it did.
+// Phases are only timed when asked for, since reading the clock isn't free; the counts are
+// always kept
+class TickStats
+{
+public:
+    TickStats();
+    
+        // Called by the world at the start of each tick, and after each phase of it
+    void begin(const bool& timed);
+    void endPhase(const char* name);
+    
+        // Called for every collision query, with the number of Actors it had to look at
+    void countQuery(const long& candidates) { m_queries++; m_candidates += candidates; }
+    
+    void dump(std::ostream& out) const;
+    
+private:
+    using Clock = std::chrono::steady_clock;
+    
+    bool              m_timed;
+    Clock::time_point m_phaseStart;
+    const char*       m_phaseNames[MAX_TICK_PHASES];
+    double            m_phaseMs[MAX_TICK_PHASES];
+    int               m_phases;
+    long              m_queries;
+    long              m_candidates;
+};
+
+#endif // ACTORSTATS_H_
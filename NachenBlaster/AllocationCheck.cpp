@@ -0,0 +1,101 @@
+#include "AllocationCheck.h"
+#include <cstdlib>
+#include <new>
+using namespace std;
+
+  // Plain ints and bools, so the first allocation a thread makes doesn't
+  // have to construct anything
+
+static thread_local unsigned long t_allocations = 0;
+static thread_local bool t_armed = false;
+static thread_local size_t t_lastArmedSize = 0;
+
+unsigned long allocationCount()
+{
+	return t_allocations;
+}
+
+void armAllocationCheck(bool on)
+{
+	t_armed = on;
+}
+
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+void allocatedWhileArmed(size_t size)
+{
+	t_lastArmedSize = size;
+}
+
+size_t lastArmedAllocationSize()
+{
+	return t_lastArmedSize;
+}
+
+  // Every replaceable form in C++14 (plain, array, sized and nothrow) is
+  // defined here, so none of them can pair this malloc() with some other
+  // library's delete.  The C++17 align_val_t forms aren't: the game never
+  // asks for over-aligned memory, and the library's own aligned new and
+  // delete still pair with each other.
+
+static void* countedAllocation(size_t size) noexcept
+{
+	t_allocations++;
+	if (t_armed)
+		allocatedWhileArmed(size);
+	return malloc(size == 0 ? 1 : size);
+}
+
+void* operator new(size_t size)
+{
+	void* p = countedAllocation(size);
+	if (p == nullptr)
+		throw bad_alloc();
+	return p;
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(size_t size, const nothrow_t&) noexcept
+{
+	return countedAllocation(size);
+}
+
+void* operator new[](size_t size, const nothrow_t&) noexcept
+{
+	return countedAllocation(size);
+}
+
+void operator delete(void* p) noexcept
+{
+	free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+	free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+	free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept
+{
+	free(p);
+}
+
+void operator delete(void* p, const nothrow_t&) noexcept
+{
+	free(p);
+}
+
+void operator delete[](void* p, const nothrow_t&) noexcept
+{
+	free(p);
+}
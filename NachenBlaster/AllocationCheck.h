@@ -0,0 +1,25 @@
+#ifndef ALLOCATIONCHECK_H_
+#define ALLOCATIONCHECK_H_
+
+#include <cstddef>
+
+  // Global operator new and delete are replaced (in AllocationCheck.cpp) so
+  // every heap allocation is counted, per thread.  That file is part of
+  // every build, not just ones run with --alloc-check, so they're always
+  // replaced; counting is all they do unless a check is armed, so leaving
+  // them in costs next to nothing.  Only the C++14 forms are replaced:
+  // allocations through the C++17 align_val_t forms aren't counted.
+
+  // How many heap allocations the calling thread has made
+unsigned long allocationCount();
+
+  // While armed, every allocation the calling thread makes also goes
+  // through allocatedWhileArmed(), which is the place for a breakpoint when
+  // something allocates that shouldn't
+void armAllocationCheck(bool on);
+void allocatedWhileArmed(std::size_t size);
+
+  // The size of the last allocation made while armed
+std::size_t lastArmedAllocationSize();
+
+#endif // ALLOCATIONCHECK_H_
@@ -0,0 +1,84 @@
+#include "Autopilot.h"
+#include "Actor.h"
+#include "StudentWorld.h"
+#include "GameConstants.h"
+#include <cmath>
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Autopilot Implementation
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Autopilot::plan(StudentWorld* world)
+{
+    const Blaster* blaster = world->getBlaster();
+    if (blaster == nullptr || !blaster->isAlive())
+        return;
+    double bx = blaster->getX();
+    double by = blaster->getY();
+    
+    // Stick with the last target while it's still ahead, rather than switching back and forth
+    // between Aliens that are about equally close
+    const Actor* target = world->resolve(m_target);
+    if (target != nullptr && (!target->isAlive() || target->getX() <= bx))
+        target = nullptr;
+    bool keepTarget = target != nullptr;
+    
+    // Find the closest threat in the Blaster's lane, and otherwise the closest Alien to shoot at
+    const Actor* threat = nullptr;
+    world->forEachCollidable([&](const Actor* a)
+    {
+        if (!a->isAlive())
+            return;
+        if (threatens(a, bx, by) && (threat == nullptr || a->getX() < threat->getX()))
+            threat = a;
+        if (!keepTarget && a->isAlien() && a->getX() > bx && (target == nullptr || a->getX() < target->getX()))
+            target = a;
+    });
+    m_target = (target != nullptr) ? target->getHandle() : ActorHandle();
+    
+    // Dodging comes first: step out of the threat's lane, away from the edge if there's no room
+    if (threat != nullptr)
+    {
+        bool goUp = threat->getY() < by;
+        if (goUp && by + BLASTER_SPEED > VIEW_HEIGHT-1)
+            goUp = false;
+        else if (!goUp && by - BLASTER_SPEED < 0)
+            goUp = true;
+        world->injectKey(goUp ? KEY_PRESS_UP : KEY_PRESS_DOWN);
+    }
+    else if (target != nullptr)
+    {
+        // Line up with the target
+        double dy = target->getY() - by;
+        if (dy > AUTOPILOT_AIM_TOLERANCE / 2)
+            world->injectKey(KEY_PRESS_UP);
+        else if (dy < -AUTOPILOT_AIM_TOLERANCE / 2)
+            world->injectKey(KEY_PRESS_DOWN);
+    }
+    
+    // Fire at whatever is lined up; torpedoes are saved for the Snagglegons
+    if (target != nullptr && abs(target->getY() - by) <= AUTOPILOT_AIM_TOLERANCE)
+    {
+        if (target->getImageID() == IID_SNAGGLEGON && blaster->getTorpedoes() > 0)
+            world->injectKey(KEY_PRESS_TAB);
+        else if (blaster->getEnergy() >= CABBAGE_COST)
+            world->injectKey(KEY_PRESS_SPACE);
+    }
+}
+
+// Whether a is headed for the Blaster: an Alien, or something an Alien shot, that is ahead of
+// the Blaster and close to its lane
+bool Autopilot::threatens(const Actor* a, const double& bx, const double& by) const
+{
+    double margin;
+    if (a->isAlien())
+        margin = AUTOPILOT_ALIEN_MARGIN;
+    else if (a->isProjectile() && static_cast<const Projectile*>(a)->shotBy() == SHOT_BY_ALIEN)
+        margin = AUTOPILOT_SHOT_MARGIN;
+    else
+        return false;
+    
+    double dx = a->getX() - bx;
+    return dx > -margin && dx < AUTOPILOT_LOOKAHEAD && abs(a->getY() - by) < margin;
+}
@@ -0,0 +1,32 @@
+#ifndef AUTOPILOT_H_
+#define AUTOPILOT_H_
+
+#include "ActorHandle.h"
+
+class StudentWorld;
+class Actor;
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Autopilot Declaration
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+const double AUTOPILOT_LOOKAHEAD     = 96; // How far ahead of the Blaster (in pixels) threats are noticed
+const double AUTOPILOT_SHOT_MARGIN   = 12; // How close a projectile's path can come before the Blaster dodges
+const double AUTOPILOT_ALIEN_MARGIN  = 20; // Same, for an Alien about to ram the Blaster
+const double AUTOPILOT_AIM_TOLERANCE = 6;  // How far off an Alien's y-coordinate can be to still fire at it
+
+// Plays the game in place of a human: each tick it looks at the Blaster, the Aliens, and their
+// projectiles, and injects the keys a player would press through GameWorld::injectKey, so the
+// Blaster handles them exactly as it would real key presses
+class Autopilot
+{
+public:
+    void plan(StudentWorld* world);
+    
+private:
+    bool threatens(const Actor* a, const double& bx, const double& by) const;
+    
+    ActorHandle m_target; // The Alien being aimed at, kept until it dies or gets past the Blaster
+};
+
+#endif // AUTOPILOT_H_
@@ -0,0 +1,256 @@
+#ifndef BACKGROUNDLAYER_H_
+#define BACKGROUNDLAYER_H_
+
+#include "freeglut.h"
+#include "Framebuffer.h"
+#include "GameConstants.h"
+#include "GameWorld.h"
+#include "GraphObject.h"
+#include "RenderSnapshot.h"
+#include "SpriteManager.h"
+#include <algorithm>
+#include <cmath>
+
+  // Draws the background (everything at GraphObject::BACKGROUND_DEPTH) as
+  // one textured quad instead of sprite by sprite.  The background only
+  // ever scrolls left as a whole (see GameWorld::scrollBackground), so it's
+  // kept in a texture used as a ring a little wider than the window: a
+  // point of the background stays in the same column for as long as it's
+  // on screen, each frame just starts reading the ring further along, and
+  // the only drawing into it is clearing and redrawing the columns that
+  // scrolled into view, or that new objects appeared in, since the last
+  // frame.  The extra width keeps what just scrolled off the left edge
+  // around, for drawing between snapshots.
+  //
+  // Objects that leave the background stay in the ring until they scroll
+  // out of the window, instead of vanishing wherever they were removed.
+  //
+  // Without framebuffer objects (see Framebuffer.h), draw() returns false
+  // and the background has to be drawn sprite by sprite as before.
+
+class BackgroundLayer
+{
+public:
+	BackgroundLayer()
+	 : m_width(0), m_height(0), m_slack(0), m_valid(false), m_epoch(0), m_scroll(0), m_originX(0),
+	   m_pixelsPerUnit(0)
+	{
+	}
+
+	  // Brings the ring up to date with snap and draws it, scrolled blend of
+	  // the way from the previous snapshot to this one.  Must be called with
+	  // the projection and modelview that sprites are plotted with.  Returns
+	  // false, having drawn nothing, if the background can't be cached.
+	bool draw(SpriteManager& sprites, const RenderSnapshot& snap, double blend)
+	{
+		GLint viewport[4];
+		GLdouble modelview[16];
+		GLdouble projection[16];
+		glGetIntegerv(GL_VIEWPORT, viewport);
+		glGetDoublev(GL_MODELVIEW_MATRIX, modelview);
+		glGetDoublev(GL_PROJECTION_MATRIX, projection);
+		if (viewport[2] <= 0  ||  viewport[3] <= 0)
+			return false;
+		if (viewport[2] != m_width  ||  viewport[3] != m_height)
+		{
+			if (!resize(viewport[2], viewport[3]))
+				return false;
+		}
+
+		  // Every sprite is in one plane, so world x maps to window x linearly
+		double gx, gy, gz, left, right, glUnitRight, unused;
+		SpriteManager::convertToGlutCoords(0, 0, gx, gy, gz);
+		gluProject(gx, gy, gz, modelview, projection, viewport, &left, &unused, &unused);
+		SpriteManager::convertToGlutCoords(VIEW_WIDTH, 0, gx, gy, gz);
+		gluProject(gx, gy, gz, modelview, projection, viewport, &right, &unused, &unused);
+		gluProject(gx + 1, gy, gz, modelview, projection, viewport, &glUnitRight, &unused, &unused);
+		double originX = left - viewport[0];
+		double pixelsPerUnit = (right - left) / VIEW_WIDTH;
+		double pixelsPerGLUnit = glUnitRight - right;
+
+		  // Window columns from firstStale on aren't in the ring yet: the ones
+		  // scrolled into view, and any that new objects could reach into
+		double firstStale = -static_cast<double>(m_slack);
+		double scrolled = snap.backgroundScroll - m_scroll;
+		if (m_valid  &&  snap.backgroundEpoch == m_epoch  &&  originX == m_originX  &&
+			pixelsPerUnit == m_pixelsPerUnit  &&  scrolled >= 0)
+		{
+			double reach = 0;
+			for (const RenderItem& item : snap.items)
+			{
+				if (item.depth == GraphObject::BACKGROUND_DEPTH  &&  spriteReach(item, pixelsPerGLUnit) > reach)
+					reach = spriteReach(item, pixelsPerGLUnit);
+			}
+			double entry = originX + (BACKGROUND_ENTRY_X - scrolled) * pixelsPerUnit - reach;
+			firstStale = std::min(m_width - scrolled * pixelsPerUnit, entry) - EDGE_PIXELS;
+			if (scrolled == 0)
+				firstStale = m_width;
+		}
+		if (firstStale < m_width)
+			update(sprites, snap, projection, pixelsPerUnit, originX, pixelsPerGLUnit, std::max(firstStale, -static_cast<double>(m_slack)));
+
+		m_valid = true;
+		m_epoch = snap.backgroundEpoch;
+		m_scroll = snap.backgroundScroll;
+		m_originX = originX;
+		m_pixelsPerUnit = pixelsPerUnit;
+
+		  // The ring only goes back m_slack pixels past the left edge
+		double shown = snap.backgroundScroll;
+		if (blend < 1)
+		{
+			shown = snap.fromBackgroundScroll + (snap.backgroundScroll - snap.fromBackgroundScroll) * blend;
+			shown = std::max(shown, snap.backgroundScroll - m_slack / pixelsPerUnit);
+		}
+		composite(shown * pixelsPerUnit);
+		return true;
+	}
+
+private:
+	  // Extra columns redrawn past the stale ones, for filtering and rounding
+	static const int EDGE_PIXELS = 2;
+
+	Framebuffer		m_ring;
+	int				m_width;	// of the window; the ring is m_width + m_slack wide
+	int				m_height;
+	int				m_slack;
+
+	  // What the ring holds: the background of the given epoch as of the
+	  // given scroll, drawn with the given mapping from world x to window x
+	bool			m_valid;
+	unsigned int	m_epoch;
+	double			m_scroll;
+	double			m_originX;
+	double			m_pixelsPerUnit;
+
+	  // How far from its center, in pixels, a sprite can reach however it's
+	  // turned
+	static double spriteReach(const RenderItem& item, double pixelsPerGLUnit)
+	{
+		return std::max(SPRITE_WIDTH_GL, SPRITE_HEIGHT_GL) * item.size * pixelsPerGLUnit;
+	}
+
+	  // Makes the ring fit a window this size
+	bool resize(int width, int height)
+	{
+		m_valid = false;
+		m_width = m_height = 0;
+		m_slack = width / 4;
+		if (!m_ring.resize(width + m_slack, height, GL_LINEAR, GL_REPEAT))
+			return false;
+		m_width = width;
+		m_height = height;
+		return true;
+	}
+
+	  // Clears the ring's columns for window columns firstStale onward and
+	  // redraws every background object that reaches into them.  A point at
+	  // window column x is kept in ring column x + (scroll in pixels),
+	  // wrapped, so sprites are drawn into the ring through the window's
+	  // projection squeezed to the ring's width and slid along by that much,
+	  // and again a ring's width to the left for anything that wraps.
+	void update(SpriteManager& sprites, const RenderSnapshot& snap, const GLdouble* projection,
+				double pixelsPerUnit, double originX, double pixelsPerGLUnit, double firstStale)
+	{
+		int ringWidth = m_width + m_slack;
+		double offset = std::fmod(snap.backgroundScroll * pixelsPerUnit, ringWidth);
+
+		m_ring.bind();
+		glPushAttrib(GL_VIEWPORT_BIT | GL_SCISSOR_BIT | GL_COLOR_BUFFER_BIT | GL_ENABLE_BIT);
+		glViewport(0, 0, ringWidth, m_height);
+		glClearColor(0, 0, 0, 0);
+		glEnable(GL_SCISSOR_TEST);
+		glMatrixMode(GL_PROJECTION);
+		glPushMatrix();
+
+		const double starts[2] = { offset, offset - ringWidth };
+		for (double start : starts)
+		{
+			int from = std::max(0, static_cast<int>(std::floor(start + firstStale)));
+			int to = std::min(ringWidth, static_cast<int>(std::ceil(start + m_width)));
+			if (from >= to)
+				continue;
+			glScissor(from, 0, to - from, m_height);
+			glClear(GL_COLOR_BUFFER_BIT);
+
+			  // Window column x, at (x / m_width) * 2 - 1 in normalized device
+			  // coordinates, goes to ring column x + start
+			glLoadIdentity();
+			glTranslated((m_width + 2 * start) / ringWidth - 1, 0, 0);
+			glScaled(static_cast<double>(m_width) / ringWidth, 1, 1);
+			glMultMatrixd(projection);
+			glMatrixMode(GL_MODELVIEW);
+
+			  // Everything reaching into the scissored columns, which may be
+			  // a little wider than the stale ones after rounding
+			double firstColumn = from - start - 1;
+			double lastColumn = to - start + 1;
+			for (const RenderItem& item : snap.items)
+			{
+				if (item.depth != GraphObject::BACKGROUND_DEPTH)
+					continue;
+				double x = originX + item.x * pixelsPerUnit;
+				double reach = spriteReach(item, pixelsPerGLUnit);
+				if (x + reach < firstColumn  ||  x - reach > lastColumn)
+					continue;
+				int frame = item.animationNumber % sprites.getNumFrames(item.imageID);
+				sprites.plotSprite(item.imageID, frame, item.x, item.y, item.angle, item.size);
+			}
+			glMatrixMode(GL_PROJECTION);
+		}
+
+		glPopMatrix();
+		glMatrixMode(GL_MODELVIEW);
+		glPopAttrib();
+		m_ring.unbind();
+	}
+
+	  // Draws the window's worth of the ring starting scrollPixels into it
+	void composite(double scrollPixels)
+	{
+		int ringWidth = m_width + m_slack;
+		double u0 = std::fmod(scrollPixels, ringWidth) / ringWidth;
+		double u1 = u0 + static_cast<double>(m_width) / ringWidth;
+
+		glMatrixMode(GL_PROJECTION);
+		glPushMatrix();
+		glLoadIdentity();
+		glOrtho(0, 1, 0, 1, -1, 1);
+		glMatrixMode(GL_MODELVIEW);
+		glPushMatrix();
+		glLoadIdentity();
+		glPushAttrib(GL_COLOR_BUFFER_BIT | GL_ENABLE_BIT | GL_TEXTURE_BIT | GL_CURRENT_BIT);
+
+		glDisable(GL_DEPTH_TEST);
+		glEnable(GL_TEXTURE_2D);
+		  // The ring was cleared to transparent black and sprites blended
+		  // into it, so its colors are already multiplied by coverage
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+		glBindTexture(GL_TEXTURE_2D, m_ring.getTexture());
+		glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+		glColor4f(1, 1, 1, 1);
+		glBegin(GL_QUADS);
+		glTexCoord2d(u0, 0);
+		glVertex2f(0, 0);
+		glTexCoord2d(u1, 0);
+		glVertex2f(1, 0);
+		glTexCoord2d(u1, 1);
+		glVertex2f(1, 1);
+		glTexCoord2d(u0, 1);
+		glVertex2f(0, 1);
+		glEnd();
+
+		glPopAttrib();
+		glMatrixMode(GL_PROJECTION);
+		glPopMatrix();
+		glMatrixMode(GL_MODELVIEW);
+		glPopMatrix();
+	}
+
+	  // Prevent copying or assigning BackgroundLayers
+	BackgroundLayer(const BackgroundLayer&) = delete;
+	BackgroundLayer& operator=(const BackgroundLayer&) = delete;
+};
+
+#endif // BACKGROUNDLAYER_H_
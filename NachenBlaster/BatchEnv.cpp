@@ -0,0 +1,304 @@
+#include "BatchEnv.h"
+#include "StudentWorld.h"
+#include "OccupancyGrid.h"
+#include "Actor.h"
+#include "GameConstants.h"
+#include <algorithm>
+using namespace std;
+
+// The key each action presses
+static const int ACTION_KEYS[NUM_ACTIONS] =
+{
+    0,
+    KEY_PRESS_UP,
+    KEY_PRESS_DOWN,
+    KEY_PRESS_LEFT,
+    KEY_PRESS_RIGHT,
+    KEY_PRESS_SPACE,
+    KEY_PRESS_TAB,
+};
+
+// Keeps the closest K things seen so far, sorted by distance
+template<int K>
+struct Nearest
+{
+    Nearest() : count(0) {}
+    
+    void consider(const Actor* a, const double& distanceSquared)
+    {
+        if (count == K && distanceSquared >= distances[K-1])
+            return;
+        int i = count < K ? count++ : K - 1;
+        for (; i > 0 && distances[i-1] > distanceSquared; i--)
+        {
+            actors[i] = actors[i-1];
+            distances[i] = distances[i-1];
+        }
+        actors[i] = a;
+        distances[i] = distanceSquared;
+    }
+    
+    const Actor* actors[K];
+    double distances[K];
+    int count;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// BatchEnv Implementation
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+BatchEnv::BatchEnv(const int& numWorlds, int threads, const long& maxEpisodeSteps)
+: m_worlds(numWorlds), m_observations(static_cast<size_t>(numWorlds) * OBSERVATION_SIZE),
+  m_rewards(numWorlds), m_dones(numWorlds), m_gridWidth(0), m_gridHeight(0), m_actions(nullptr), m_seed(0),
+  m_maxEpisodeSteps(maxEpisodeSteps), m_generation(0), m_busyWorkers(0), m_quit(false),
+  m_job(nullptr), m_nextWorld(0)
+{
+    for (World& w : m_worlds)
+    {
+        w.world = nullptr;
+        w.episodes = 0;
+    }
+    
+    if (threads <= 0)
+        threads = max(1u, thread::hardware_concurrency());
+    threads = min(threads, max(1, numWorlds));
+    
+    // The thread calling step() does its share of the work too
+    for (int k = 1; k < threads; k++)
+        m_workers.push_back(thread(&BatchEnv::workerLoop, this));
+}
+
+BatchEnv::~BatchEnv()
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_quit = true;
+    }
+    m_startCV.notify_all();
+    for (thread& t : m_workers)
+        t.join();
+    for (World& w : m_worlds)
+        delete w.world;
+}
+
+void BatchEnv::reset(const unsigned int& seed)
+{
+    m_seed = seed;
+    runJob(&BatchEnv::resetWorld);
+}
+
+void BatchEnv::step(const int* actions)
+{
+    m_actions = actions;
+    runJob(&BatchEnv::stepWorld);
+}
+
+void BatchEnv::setGridSize(const int& width, const int& height)
+{
+    m_gridWidth = width;
+    m_gridHeight = height;
+    m_grids.assign(static_cast<size_t>(numWorlds()) * GRID_CHANNELS * width * height, 0);
+}
+
+long BatchEnv::episodesFinished() const
+{
+    long total = 0;
+    for (const World& w : m_worlds)
+        total += w.episodes;
+    return total;
+}
+
+// Starts world i's next game with the next seed in its sequence
+void BatchEnv::startEpisode(const int& i)
+{
+    World& w = m_worlds[i];
+    w.random.seed(w.nextSeed);
+    w.nextSeed += numWorlds();
+    
+    // Each world is made once and then reused, so episodes don't go back to the heap for one.
+    // Nobody sees a batch's worlds, so they skip everything cosmetic
+    if (w.world == nullptr)
+    {
+        w.world = new StudentWorld("");
+        w.world->setQuality(QUALITY_MIN);
+    }
+    else
+    {
+        w.world->cleanUp();
+        w.world->restartGame();
+    }
+    w.world->init();
+    w.score = w.world->getScore();
+    w.lives = w.world->getLives();
+    w.episodeSteps = 0;
+}
+
+void BatchEnv::resetWorld(const int& i)
+{
+    World& w = m_worlds[i];
+    w.nextSeed = m_seed + i;
+    w.episodes = 0;
+    startEpisode(i);
+    m_rewards[i] = 0;
+    m_dones[i] = 0;
+    observe(i);
+}
+
+// The same as one tick of GameController, with the level and life changes it makes in between
+void BatchEnv::stepWorld(const int& i)
+{
+    World& w = m_worlds[i];
+    StudentWorld* world = w.world;
+    
+    int action = m_actions[i];
+    if (action > ACTION_NONE && action < NUM_ACTIONS)
+        world->injectKey(ACTION_KEYS[action]);
+    
+    int status = world->move();
+    w.episodeSteps++;
+    if (status == GWSTATUS_FINISHED_LEVEL)
+        world->advanceToNextLevel();
+    
+    // decLives() has already been called by the time a death is reported
+    unsigned int score = world->getScore();
+    unsigned int lives = world->getLives();
+    double reward = (score - w.score) * REWARD_PER_POINT;
+    if (lives < w.lives)
+        reward += (w.lives - lives) * REWARD_PER_LIFE_LOST;
+    w.score = score;
+    w.lives = lives;
+    
+    bool done = false;
+    if (status == GWSTATUS_PLAYER_DIED || status == GWSTATUS_FINISHED_LEVEL)
+    {
+        world->cleanUp();
+        if (world->isGameOver())
+            done = true;
+        else
+            world->init();
+    }
+    if (m_maxEpisodeSteps > 0 && w.episodeSteps >= m_maxEpisodeSteps)
+        done = true;
+    
+    if (done)
+    {
+        w.episodes++;
+        startEpisode(i);
+    }
+    m_rewards[i] = static_cast<float>(reward);
+    m_dones[i] = done;
+    observe(i);
+}
+
+// Writes world i's row of observations
+void BatchEnv::observe(const int& i)
+{
+    const StudentWorld* world = m_worlds[i].world;
+    const Blaster* blaster = world->getBlaster();
+    double bx = blaster->getX();
+    double by = blaster->getY();
+    
+    Nearest<OBS_NEAREST_ALIENS> aliens;
+    Nearest<OBS_NEAREST_SHOTS> shots;
+    world->forEachCollidable([&](const Actor* a)
+    {
+        if (!a->isAlive())
+            return;
+        double dx = a->getX() - bx;
+        double dy = a->getY() - by;
+        if (a->isAlien())
+            aliens.consider(a, dx * dx + dy * dy);
+        else if (a->getLayer() == LAYER_ALIEN_SHOTS)
+            shots.consider(a, dx * dx + dy * dy);
+    });
+    
+    float* out = &m_observations[static_cast<size_t>(i) * OBSERVATION_SIZE];
+    *out++ = static_cast<float>(bx);
+    *out++ = static_cast<float>(by);
+    *out++ = static_cast<float>(blaster->getHealth());
+    *out++ = static_cast<float>(blaster->getEnergy());
+    *out++ = static_cast<float>(blaster->getTorpedoes());
+    for (int k = 0; k < OBS_NEAREST_ALIENS; k++)
+    {
+        bool present = k < aliens.count;
+        const Actor* a = aliens.actors[k];
+        *out++ = present;
+        *out++ = present ? static_cast<float>(a->getX() - bx) : 0;
+        *out++ = present ? static_cast<float>(a->getY() - by) : 0;
+        *out++ = present ? static_cast<float>(static_cast<const DamageableObject*>(a)->getHealth()) : 0;
+    }
+    for (int k = 0; k < OBS_NEAREST_SHOTS; k++)
+    {
+        bool present = k < shots.count;
+        const Actor* a = shots.actors[k];
+        *out++ = present;
+        *out++ = present ? static_cast<float>(a->getX() - bx) : 0;
+        *out++ = present ? static_cast<float>(a->getY() - by) : 0;
+    }
+    
+    if (!m_grids.empty())
+    {
+        size_t gridSize = static_cast<size_t>(GRID_CHANNELS) * m_gridWidth * m_gridHeight;
+        rasterizeOccupancy(*world, m_gridWidth, m_gridHeight, &m_grids[i * gridSize]);
+    }
+}
+
+// Runs job on every world, spread across the calling thread and the workers
+void BatchEnv::runJob(const Job& job)
+{
+    m_job = job;
+    m_nextWorld = 0;
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_generation++;
+        m_busyWorkers = static_cast<int>(m_workers.size());
+    }
+    m_startCV.notify_all();
+    
+    // The calling thread may be running a game of its own, so it only borrows the batch's
+    // settings while it helps out
+    bool& tracking = GraphObject::tracksNewObjects();
+    bool wasTracking = tracking;
+    mt19937* generator = threadGenerator();
+    tracking = false;
+    runWorlds();
+    tracking = wasTracking;
+    threadGenerator() = generator;
+    
+    unique_lock<mutex> lock(m_mutex);
+    m_doneCV.wait(lock, [this] { return m_busyWorkers == 0; });
+}
+
+void BatchEnv::runWorlds()
+{
+    int n = numWorlds();
+    for (int i = m_nextWorld++; i < n; i = m_nextWorld++)
+    {
+        threadGenerator() = &m_worlds[i].random;
+        (this->*m_job)(i);
+    }
+}
+
+void BatchEnv::workerLoop()
+{
+    // Nothing in a batch is ever drawn
+    GraphObject::tracksNewObjects() = false;
+    
+    unsigned long seen = 0;
+    for (;;)
+    {
+        {
+            unique_lock<mutex> lock(m_mutex);
+            m_startCV.wait(lock, [&] { return m_quit || m_generation != seen; });
+            if (m_quit)
+                return;
+            seen = m_generation;
+        }
+    
+        runWorlds();
+    
+        lock_guard<mutex> lock(m_mutex);
+        if (--m_busyWorkers == 0)
+            m_doneCV.notify_one();
+    }
+}
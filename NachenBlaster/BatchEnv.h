@@ -0,0 +1,125 @@
+#ifndef BATCHENV_H_
+#define BATCHENV_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+class StudentWorld;
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Manifest Constants
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+const int ACTION_NONE    = 0; // What the Blaster can do each step; one key press at most
+const int ACTION_UP      = 1;
+const int ACTION_DOWN    = 2;
+const int ACTION_LEFT    = 3;
+const int ACTION_RIGHT   = 4;
+const int ACTION_CABBAGE = 5;
+const int ACTION_TORPEDO = 6;
+const int NUM_ACTIONS    = 7;
+
+const int OBS_BLASTER_SIZE   = 5; // x, y, health, energy, torpedoes
+const int OBS_NEAREST_ALIENS = 4; // The closest Aliens to the Blaster, closest first
+const int OBS_ALIEN_SIZE     = 4; // present (1 or 0), x and y relative to the Blaster, health
+const int OBS_NEAREST_SHOTS  = 4; // The closest projectiles Aliens fired, closest first
+const int OBS_SHOT_SIZE      = 3; // present (1 or 0), x and y relative to the Blaster
+const int OBSERVATION_SIZE   = OBS_BLASTER_SIZE + OBS_NEAREST_ALIENS * OBS_ALIEN_SIZE +
+                               OBS_NEAREST_SHOTS * OBS_SHOT_SIZE;
+
+const double REWARD_PER_POINT     = 0.01; // Rewards come from the score the world adds up,
+const double REWARD_PER_LIFE_LOST = -10;  // and the lives it takes away
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// BatchEnv Declaration
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Runs many independent games at once for training and evaluating agents, with no window, sound,
+// or GameController. Each step() advances every world one tick, spread across a pool of threads,
+// and writes each world's observation, reward, and done flag into buffers that are allocated
+// once and never move, so callers can keep pointers into them.
+//
+// Every world has a random generator of its own, so a world plays the same way for the same seed
+// and actions no matter how many threads there are or which one runs it. A world that finishes an
+// episode starts the next one right away (with the next seed in its sequence); its done flag is
+// set for that step, and its observation is already the new episode's first.
+class BatchEnv
+{
+public:
+        // threads == 0 means one thread per core. maxEpisodeSteps == 0 means episodes only end
+        // when the game does
+    BatchEnv(const int& numWorlds, int threads = 0, const long& maxEpisodeSteps = 0);
+    ~BatchEnv();
+    
+        // World i plays seed + i, then seed + i + numWorlds, and so on
+    void reset(const unsigned int& seed);
+    
+        // actions holds one ACTION_ per world
+    void step(const int* actions);
+    
+        // Also rasterizes every world's occupancy grid (see OccupancyGrid.h) on each reset() and
+        // step(). This allocates the grid buffer, so call it before keeping pointers into it
+    void setGridSize(const int& width, const int& height);
+    
+        // Accessors
+    int numWorlds() const                    { return static_cast<int>(m_worlds.size()); }
+    const float* observations() const        { return m_observations.data(); } // numWorlds x OBSERVATION_SIZE
+    const float* rewards() const             { return m_rewards.data(); }
+    const unsigned char* dones() const       { return m_dones.data(); }
+    const float* grids() const               { return m_grids.empty() ? nullptr : m_grids.data(); } // numWorlds x GRID_CHANNELS x height x width
+    long episodesFinished() const;
+    
+private:
+    struct World
+    {
+        StudentWorld* world;
+        std::mt19937  random;
+        unsigned int  nextSeed;
+        unsigned int  score;  // As of the last step, to turn changes into rewards
+        unsigned int  lives;
+        long          episodeSteps;
+        long          episodes;
+    };
+    
+    void startEpisode(const int& i);
+    void resetWorld(const int& i);
+    void stepWorld(const int& i);
+    void observe(const int& i);
+    
+    std::vector<World>         m_worlds;
+    std::vector<float>         m_observations;
+    std::vector<float>         m_rewards;
+    std::vector<unsigned char> m_dones;
+    std::vector<float>         m_grids;
+    int                        m_gridWidth;
+    int                        m_gridHeight;
+    const int*                 m_actions;
+    unsigned int               m_seed;
+    long                       m_maxEpisodeSteps;
+    
+        // Worker threads wait for m_generation to change, then take worlds from m_nextWorld and
+        // run m_job on them until there are none left
+    using Job = void (BatchEnv::*)(const int&);
+    void runJob(const Job& job);
+    void runWorlds();
+    void workerLoop();
+    
+    std::vector<std::thread> m_workers;
+    std::mutex               m_mutex;
+    std::condition_variable  m_startCV;
+    std::condition_variable  m_doneCV;
+    unsigned long            m_generation;
+    int                      m_busyWorkers;
+    bool                     m_quit;
+    Job                      m_job;
+    std::atomic<int>         m_nextWorld;
+    
+    BatchEnv(const BatchEnv&) = delete;
+    BatchEnv& operator=(const BatchEnv&) = delete;
+};
+
+#endif // BATCHENV_H_
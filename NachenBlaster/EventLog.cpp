@@ -0,0 +1,84 @@
+#include "EventLog.h"
+#include <chrono>
+#include <iostream>
+using namespace std;
+
+static const int FLUSH_INTERVAL_MS = 50;
+
+EventLog::EventLog()
+ : m_file(nullptr), m_dropped(0), m_quit(false)
+{
+}
+
+EventLog::~EventLog()
+{
+	close();
+}
+
+bool EventLog::open(const string& filename)
+{
+	close();
+	m_file = fopen(filename.c_str(), "wb");
+	if (m_file == nullptr)
+		return false;
+
+	GameEventLogHeader header = { { 'N', 'B', 'E', 'V' }, EVENT_LOG_VERSION, sizeof(GameEvent) };
+	fwrite(&header, sizeof(header), 1, m_file);
+
+	  // Kept from one open() to the next; close() leaves it empty
+	if (m_queue == nullptr)
+		m_queue.reset(new SpscRing<GameEvent, EVENT_LOG_QUEUE_SIZE>);
+	m_dropped = 0;
+	m_quit = false;
+	m_batch.reserve(EVENT_LOG_QUEUE_SIZE);
+	m_flushThread = thread(&EventLog::flushLoop, this);
+	return true;
+}
+
+void EventLog::close()
+{
+	if (m_file == nullptr)
+		return;
+
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_quit = true;
+	}
+	m_cv.notify_one();
+	m_flushThread.join();
+
+	  // Whatever was recorded after the thread's last pass
+	flush();
+	fclose(m_file);
+	m_file = nullptr;
+
+	if (m_dropped > 0)
+		cout << "Event log dropped " << m_dropped << " events" << endl;
+}
+
+void EventLog::flushLoop()
+{
+	unique_lock<mutex> lock(m_mutex);
+	while (!m_quit)
+	{
+		m_cv.wait_for(lock, chrono::milliseconds(FLUSH_INTERVAL_MS));
+		lock.unlock();
+		flush();
+		lock.lock();
+	}
+}
+
+  // Only ever called by one thread at a time: the flush thread, or close()
+  // once that thread has finished
+void EventLog::flush()
+{
+	m_batch.clear();
+	GameEvent e;
+	while (m_queue->pop(e))
+		m_batch.push_back(e);
+	if (!m_batch.empty())
+	{
+		fwrite(m_batch.data(), sizeof(GameEvent), m_batch.size(), m_file);
+		fflush(m_file);
+	}
+}
@@ -0,0 +1,109 @@
+#ifndef EVENTLOG_H_
+#define EVENTLOG_H_
+
+#include "InputQueue.h"
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+  // Gameplay events, and what the subject and value of each one mean
+
+enum GameEventType : std::uint8_t
+{
+	EVENT_LEVEL_START,	// subject: IID_NACHENBLASTER	value: lives left
+	EVENT_LEVEL_END,	// subject: IID_NACHENBLASTER	value: GWSTATUS_PLAYER_DIED or GWSTATUS_FINISHED_LEVEL
+	EVENT_KILL,			// subject: the alien's image	value: points scored
+	EVENT_DAMAGE,		// subject: the victim's image	value: damage suffered
+	EVENT_GOODIE,		// subject: the goodie's image	value: points scored
+	EVENT_SHOT,			// subject: the projectile's image	value: SHOT_BY_PLAYER or SHOT_BY_ALIEN
+	NUM_EVENT_TYPES
+};
+
+  // One fixed-size record in the log file
+
+struct GameEvent
+{
+	std::uint32_t tick;		// ticks since the game started
+	std::uint16_t level;
+	std::uint8_t  type;		// a GameEventType
+	std::uint8_t  subject;	// an image ID
+	std::int32_t  value;
+	float		  x;
+	float		  y;
+};
+
+static_assert(sizeof(GameEvent) == 20, "GameEvent records must stay 20 bytes");
+
+  // The file starts with this header, followed by GameEvent records in the
+  // order they happened, all in the writer's byte order
+
+struct GameEventLogHeader
+{
+	char		  magic[4];		// "NBEV"
+	std::uint32_t version;
+	std::uint32_t recordSize;	// sizeof(GameEvent)
+};
+
+const std::uint32_t EVENT_LOG_VERSION = 1;
+const int EVENT_LOG_QUEUE_SIZE = 8192;
+
+  // An append-only log of GameEvents.  record() only copies the event into a
+  // ring buffer, so the simulation never waits on the disk; a background
+  // thread drains the ring into the file every few milliseconds.  If the
+  // ring ever fills up, events are dropped (and counted) rather than
+  // stalling the tick.  The ring is only allocated by open(), so a log that
+  // is never opened (as in most worlds) costs next to nothing.
+
+class EventLog
+{
+public:
+	EventLog();
+	~EventLog();
+
+	bool open(const std::string& filename);
+	void close();
+
+	bool isOpen() const
+	{
+		return m_file != nullptr;
+	}
+
+	void record(unsigned long tick, GameEventType type, unsigned int level, int subject, int value, double x, double y)
+	{
+		if (m_file == nullptr)
+			return;
+		GameEvent e = { static_cast<std::uint32_t>(tick), static_cast<std::uint16_t>(level), static_cast<std::uint8_t>(type),
+						static_cast<std::uint8_t>(subject), value, static_cast<float>(x), static_cast<float>(y) };
+		if (!m_queue->push(e))
+			m_dropped++;
+	}
+
+	long long dropped() const
+	{
+		return m_dropped;
+	}
+
+private:
+	std::FILE*				m_file;
+	long long				m_dropped;
+	std::unique_ptr<SpscRing<GameEvent, EVENT_LOG_QUEUE_SIZE>> m_queue;
+
+	std::thread				m_flushThread;
+	std::mutex				m_mutex;
+	std::condition_variable m_cv;
+	bool					m_quit;
+	std::vector<GameEvent>	m_batch;
+
+	void flushLoop();
+	void flush();
+
+	EventLog(const EventLog&) = delete;
+	EventLog& operator=(const EventLog&) = delete;
+};
+
+#endif // EVENTLOG_H_
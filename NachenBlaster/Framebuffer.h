@@ -0,0 +1,149 @@
+#ifndef FRAMEBUFFER_H_
+#define FRAMEBUFFER_H_
+
+#include "freeglut.h"
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+#ifndef GL_FRAMEBUFFER_EXT
+#define GL_FRAMEBUFFER_EXT			0x8D40
+#define GL_COLOR_ATTACHMENT0_EXT	0x8CE0
+#define GL_FRAMEBUFFER_COMPLETE_EXT 0x8CD5
+#define GL_FRAMEBUFFER_BINDING_EXT	0x8CA6
+#endif
+
+  // A texture that can be drawn into instead of the window, through
+  // EXT_framebuffer_object (which every OpenGL 2 implementation has).  Its
+  // functions aren't linked directly, so loadFunctions() must find them
+  // before any Framebuffer is used; if it can't, resize() always fails and
+  // callers should draw straight into the window instead.
+
+class Framebuffer
+{
+public:
+	  // Looks up the functions through getProcAddress, which must work for
+	  // the current context.  Returns whether they're all there.
+	static bool loadFunctions(void* (*getProcAddress)(const char* name))
+	{
+		Functions& gl = functions();
+		gl.genFramebuffers = reinterpret_cast<GenFramebuffersProc>(getProcAddress("glGenFramebuffersEXT"));
+		gl.deleteFramebuffers = reinterpret_cast<DeleteFramebuffersProc>(getProcAddress("glDeleteFramebuffersEXT"));
+		gl.bindFramebuffer = reinterpret_cast<BindFramebufferProc>(getProcAddress("glBindFramebufferEXT"));
+		gl.framebufferTexture2D = reinterpret_cast<FramebufferTexture2DProc>(getProcAddress("glFramebufferTexture2DEXT"));
+		gl.checkFramebufferStatus = reinterpret_cast<CheckFramebufferStatusProc>(getProcAddress("glCheckFramebufferStatusEXT"));
+		gl.loaded = gl.genFramebuffers != nullptr  &&  gl.deleteFramebuffers != nullptr  &&
+					gl.bindFramebuffer != nullptr  &&  gl.framebufferTexture2D != nullptr  &&
+					gl.checkFramebufferStatus != nullptr;
+		return gl.loaded;
+	}
+
+	Framebuffer()
+	 : m_framebuffer(0), m_texture(0), m_width(0), m_height(0), m_previous(0)
+	{
+	}
+
+	~Framebuffer()
+	{
+		if (m_framebuffer != 0)
+			functions().deleteFramebuffers(1, &m_framebuffer);
+		if (m_texture != 0)
+			glDeleteTextures(1, &m_texture);
+	}
+
+	  // (Re)allocates the texture, with undefined contents.  Returns false if
+	  // it can't be drawn into.
+	bool resize(int width, int height, GLint filter, GLint wrapS)
+	{
+		Functions& gl = functions();
+		m_width = m_height = 0;
+		if (!gl.loaded)
+			return false;
+
+		if (m_texture == 0)
+			glGenTextures(1, &m_texture);
+		glBindTexture(GL_TEXTURE_2D, m_texture);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapS);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+		if (m_framebuffer == 0)
+			gl.genFramebuffers(1, &m_framebuffer);
+		bind();
+		gl.framebufferTexture2D(GL_FRAMEBUFFER_EXT, GL_COLOR_ATTACHMENT0_EXT, GL_TEXTURE_2D, m_texture, 0);
+		bool complete = (gl.checkFramebufferStatus(GL_FRAMEBUFFER_EXT) == GL_FRAMEBUFFER_COMPLETE_EXT);
+		unbind();
+		if (!complete)
+			return false;
+
+		m_width = width;
+		m_height = height;
+		return true;
+	}
+
+	  // Drawing goes into the texture from bind() until unbind(), which goes
+	  // back to whatever was being drawn into before (e.g., another
+	  // Framebuffer)
+	void bind()
+	{
+		glGetIntegerv(GL_FRAMEBUFFER_BINDING_EXT, &m_previous);
+		functions().bindFramebuffer(GL_FRAMEBUFFER_EXT, m_framebuffer);
+	}
+
+	void unbind()
+	{
+		functions().bindFramebuffer(GL_FRAMEBUFFER_EXT, m_previous);
+	}
+
+	int getWidth() const
+	{
+		return m_width;
+	}
+
+	int getHeight() const
+	{
+		return m_height;
+	}
+
+	GLuint getTexture() const
+	{
+		return m_texture;
+	}
+
+private:
+	typedef void (APIENTRY *GenFramebuffersProc)(GLsizei n, GLuint* framebuffers);
+	typedef void (APIENTRY *DeleteFramebuffersProc)(GLsizei n, const GLuint* framebuffers);
+	typedef void (APIENTRY *BindFramebufferProc)(GLenum target, GLuint framebuffer);
+	typedef void (APIENTRY *FramebufferTexture2DProc)(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level);
+	typedef GLenum (APIENTRY *CheckFramebufferStatusProc)(GLenum target);
+
+	struct Functions
+	{
+		bool						loaded;
+		GenFramebuffersProc			genFramebuffers;
+		DeleteFramebuffersProc		deleteFramebuffers;
+		BindFramebufferProc			bindFramebuffer;
+		FramebufferTexture2DProc	framebufferTexture2D;
+		CheckFramebufferStatusProc	checkFramebufferStatus;
+	};
+
+	static Functions& functions()
+	{
+		static Functions gl = {};
+		return gl;
+	}
+
+	GLuint	m_framebuffer;
+	GLuint	m_texture;
+	int		m_width;
+	int		m_height;
+	GLint	m_previous;
+
+	  // Prevent copying or assigning Framebuffers
+	Framebuffer(const Framebuffer&) = delete;
+	Framebuffer& operator=(const Framebuffer&) = delete;
+};
+
+#endif // FRAMEBUFFER_H_
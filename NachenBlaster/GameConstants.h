@@ -65,6 +65,38 @@ const int GWSTATUS_LEVEL_ERROR	 = 4;
 
 const int NUM_TEST_PARAMS = 1;
 
+  // Code that runs several worlds at once (see BatchEnv) gives each world a
+  // generator of its own, and points this at it while running that world
+
+inline
+std::mt19937*& threadGenerator()
+{
+	thread_local std::mt19937* generator = nullptr;
+	return generator;
+}
+
+  // The generator behind randInt: the thread's own if it has one, otherwise
+  // a shared one that's seeded at random unless seedRandom() is called
+
+inline
+std::mt19937& randomGenerator()
+{
+	std::mt19937* own = threadGenerator();
+	if (own != nullptr)
+		return *own;
+	static std::random_device rd;
+	static std::mt19937 generator(rd());
+	return generator;
+}
+
+  // With the same seed (and the same key presses), a game plays out the same way
+
+inline
+void seedRandom(unsigned int seed)
+{
+	randomGenerator().seed(seed);
+}
+
   // Return a uniformly distributed random int from min to max, inclusive
 
 inline
@@ -72,10 +104,28 @@ int randInt(int min, int max)
 {
 	if (max < min)
 		std::swap(max, min);
-	static std::random_device rd;
-	static std::mt19937 generator(rd());
 	std::uniform_int_distribution<> distro(min, max);
-	return distro(generator);
+	return distro(randomGenerator());
+}
+
+  // Randomness that only changes how the game looks (e.g., where the stars
+  // are) comes from a generator of its own, so cosmetic choices, like how
+  // many stars there are, can never change what the game itself draws next
+
+inline
+std::mt19937& cosmeticGenerator()
+{
+	thread_local std::mt19937 generator;
+	return generator;
+}
+
+inline
+int cosmeticRandInt(int min, int max)
+{
+	if (max < min)
+		std::swap(max, min);
+	std::uniform_int_distribution<> distro(min, max);
+	return distro(cosmeticGenerator());
 }
 
 #endif // GAMECONSTANTS_H_
@@ -5,11 +5,23 @@
 #include "GraphObject.h"
 #include "SoundFX.h"
 #include "SpriteManager.h"
+#include "OffscreenContext.h"
+#include "TGAImage.h"
+#include "SoftwareRenderer.h"
+#include "GlyphAtlas.h"
+#include "AllocationCheck.h"
 #include <string>
 #include <map>
 #include <utility>
 #include <cstdlib>
 #include <algorithm>
+#include <chrono>
+#include <vector>
+#include <iomanip>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <cmath>
 using namespace std;
 
 /*
@@ -30,50 +42,116 @@ PixelHeight = RowHeight/256 = .03375
 newSpriteHeight = PixelHeight * NumPixels
 */
 
-static const int WINDOW_WIDTH = 768; //1024;
-static const int WINDOW_HEIGHT = 768;
-
 static const int PERSPECTIVE_NEAR_PLANE = 4;
 static const int PERSPECTIVE_FAR_PLANE	= 22;
 
-static const double FONT_SCALEDOWN = 760.0;
+  // Height of a character cell, in world units at the plane the text is drawn on
+static const double TEXT_HEIGHT = .2;
 
 static const double SCORE_Y = 3.8;
 static const double SCORE_Z = -10;
+static const double TURBO_Y = -3.9;
+
+  // Profiles stop growing after this many samples of each kind
+static const size_t MAX_PROFILE_SAMPLES = 1000000;
+
+  // The watchdog explains this many slow ticks (and frames) at most, and
+  // just counts the rest.  So does the allocation check.
+static const long MAX_WATCHDOG_REPORTS = 20;
 
-static const int MS_PER_FRAME = 5;
+  // Below this quality level, sprites skip their mipmaps
+static const int MIPMAP_MIN_QUALITY = QUALITY_MAX;
+
+  // Room set aside for the world's stat text, so passing it along doesn't
+  // allocate during a tick
+static const size_t MAX_STAT_TEXT = 256;
 
-static void drawPrompt(string mainMessage, string secondMessage);
-static void drawScoreAndLives(string);
 
 enum GameController::GameControllerState : int {
-	welcome, init, makemove, animate, contgame, finishedlevel, cleanup, gameover, prompt, quit, not_applicable
+	welcome, init, play, contgame, finishedlevel, cleanup, gameover, prompt, quit, not_applicable
 };
 
-void GameController::initDrawersAndSounds()
+struct SpriteInfo
+{
+	int imageID;
+	int frameNum;
+	std::string tgaFileName;
+};
+
+static const SpriteInfo drawers[] = {
+	{ IID_NACHENBLASTER , 0, "ship.tga"},
+	{ IID_SMALLGON, 0, "smallgon.tga" },
+	{ IID_SMOREGON, 0, "smoregon.tga" },
+	{ IID_SNAGGLEGON, 0, "snagglegon.tga" },
+	{ IID_REPAIR_GOODIE, 0, "health.tga" },
+	{ IID_LIFE_GOODIE, 0, "life.tga" },
+	{ IID_TORPEDO_GOODIE, 0, "sonar.tga" },
+	{ IID_TORPEDO, 0, "torpedo.tga" },
+	{ IID_TURNIP, 0, "turnip.tga" },
+	{ IID_CABBAGE, 0, "cabbage.tga"},
+	{ IID_STAR, 0, "star1.tga" },
+	{ IID_EXPLOSION, 0, "explosion.tga" },
+};
+
+  // Works with anything that loads sprites like SpriteManager does
+template<typename Renderer>
+static bool loadSprites(Renderer& renderer, string assetDirectory)
 {
-	struct SpriteInfo
+	string path = assetDirectory;
+	if (!path.empty())
+		path += '/';
+	for (int k = 0; k < sizeof(drawers)/sizeof(drawers[0]); k++)
 	{
-		int imageID;
-		int frameNum;
-		std::string tgaFileName;
-	};
+		const SpriteInfo& d = drawers[k];
+		if (!renderer.loadSprite(path + d.tgaFileName, d.imageID, d.frameNum))
+			return false;
+	}
+	return true;
+}
 
-	SpriteInfo drawers[] = {
-		{ IID_NACHENBLASTER , 0, "ship.tga"},
-		{ IID_SMALLGON, 0, "smallgon.tga" },
-		{ IID_SMOREGON, 0, "smoregon.tga" },
-		{ IID_SNAGGLEGON, 0, "snagglegon.tga" },
-		{ IID_REPAIR_GOODIE, 0, "health.tga" },
-		{ IID_LIFE_GOODIE, 0, "life.tga" },
-		{ IID_TORPEDO_GOODIE, 0, "sonar.tga" },
-		{ IID_TORPEDO, 0, "torpedo.tga" },
-		{ IID_TURNIP, 0, "turnip.tga" },
-		{ IID_CABBAGE, 0, "cabbage.tga"},
-		{ IID_STAR, 0, "star1.tga" },
-		{ IID_EXPLOSION, 0, "explosion.tga" },
-	};
+  // Turns the shorter way round, so 350 to 10 goes through 0
+static int blendAngle(int from, int to, double blend)
+{
+	int delta = to - from;
+	if (delta > 180)
+		delta -= 360;
+	else if (delta < -180)
+		delta += 360;
+	return from + static_cast<int>(lround(delta * blend));
+}
 
+  // Works with anything that plots sprites like SpriteManager does.  Each
+  // object is drawn blend of the way from where it was in the previous
+  // snapshot to where it is in this one.  Objects at skipDepth aren't drawn.
+template<typename Renderer>
+static void plotSnapshot(Renderer& renderer, const RenderSnapshot& snap, double blend, int skipDepth = -1)
+{
+	for (const RenderItem& item : snap.items)
+	{
+		if (item.depth == skipDepth)
+			continue;
+		int frame = item.animationNumber % renderer.getNumFrames(item.imageID);
+		if (blend >= 1)
+			renderer.plotSprite(item.imageID, frame, item.x, item.y, item.angle, item.size);
+		else
+			renderer.plotSprite(item.imageID, frame, item.fromX + (item.x - item.fromX) * blend,
+								item.fromY + (item.y - item.fromY) * blend,
+								blendAngle(item.fromAngle, item.angle, blend), item.size);
+	}
+}
+
+  // How far the display has got from the previous snapshot to this one,
+  // going by when this one was published and when the next is due
+static double snapshotBlend(const RenderSnapshot& snap, chrono::steady_clock::time_point now)
+{
+	if (snap.tickInterval <= chrono::steady_clock::duration::zero())
+		return 1;
+	double blend = chrono::duration<double>(now - snap.published) / snap.tickInterval;
+	return blend < 0 ? 0 : (blend > 1 ? 1 : blend);
+}
+
+void GameController::initDrawersAndSounds()
+{
 	SoundMapType::value_type sounds[] = {
 		make_pair(SOUND_THEME          , "theme.wav"),
 		make_pair(SOUND_GOODIE         , "goodie.wav"),
@@ -85,17 +163,15 @@ void GameController::initDrawersAndSounds()
 		make_pair(SOUND_TORPEDO        , "torpedo.wav"),
 	};
 
-	for (int k = 0; k < sizeof(drawers)/sizeof(drawers[0]); k++)
-	{
-		string path = m_gw->assetDirectory();
-		if (!path.empty())
-			path += '/';
-		const SpriteInfo& d = drawers[k];
-		if (!m_spriteManager.loadSprite(path + d.tgaFileName, d.imageID, d.frameNum))
-			exit(1);
-	}
+	if (!loadSprites(m_spriteManager, m_gw->assetDirectory()))
+		exit(1);
+	m_glyphAtlas.create();
+	string path = m_gw->assetDirectory();
+	if (!path.empty())
+		path += '/';
 	for (int k = 0; k < sizeof(sounds)/sizeof(sounds[0]); k++)
-		m_soundMap[sounds[k].first] = sounds[k].second;
+		m_soundMap[sounds[k].first] = path + sounds[k].second;
+	applyQuality(m_governor.level());
 }
 
 static void doSomethingCallback()
@@ -121,52 +197,554 @@ static void specialKeyboardEventCallback(int key, int x, int y)
 static void timerFuncCallback(int)
 {
 	Game().doSomething();
-	glutTimerFunc(MS_PER_FRAME, timerFuncCallback, 0);
+	glutTimerFunc(Game().getMsPerFrame(), timerFuncCallback, 0);
 }
 
-void GameController::run(int argc, char* argv[], GameWorld* gw, string windowTitle)
+void GameController::configure(const Options& options)
+{
+	m_options = options;
+	m_tickInterval = chrono::duration_cast<chrono::steady_clock::duration>(
+						chrono::duration<double>(1 / options.ticksPerSecond));
+	setTurbo(options.ticksPerFrame, options.unthrottled);
+
+	using Duration = chrono::steady_clock::duration;
+	if (options.watchdogMs >= 0)
+		m_tickBudget = m_frameBudget = chrono::duration_cast<Duration>(chrono::milliseconds(options.watchdogMs));
+	else
+	{
+		m_tickBudget = m_tickInterval;
+		m_frameBudget = chrono::duration_cast<Duration>(chrono::milliseconds(options.msPerFrame));
+	}
+	  // How much is drawn decides how many stars there are, and so what the
+	  // dumps show, so headless runs only adjust it when asked to
+	bool adjust = options.quality < 0  &&  (options.qualityGiven  ||  !options.headless);
+	m_governor.configure(m_frameBudget, options.quality < 0 ? QUALITY_MAX : options.quality, adjust);
+}
+
+void GameController::resetState(GameWorld* gw)
 {
 	gw->setController(this);
 	m_gw = gw;
 	setGameState(welcome);
-	m_lastKeyHit = INVALID_KEY;
+	m_hasUnpresentedInput = false;
+	m_droppedKeys = 0;
 	m_singleStep = false;
-	m_curIntraFrameTick = 0;
+	m_quitRequested = false;
+	m_lastPresentedTick = 0;
+	m_publishedBackgroundScroll = gw->getBackgroundScroll();
+	m_publishedBackgroundEpoch = gw->getBackgroundEpoch();
 	m_playerWon = false;
+	m_simRunning = false;
+	m_simQuit = false;
+	m_simStatus = GWSTATUS_CONTINUE_GAME;
+	m_simTick = 0;
+	m_rateStart = chrono::steady_clock::now();
+	m_rateStartTick = 0;
+	m_turboText.clear();
+	m_tickMicros.clear();
+	m_frameMicros.clear();
+	m_slowTicks = 0;
+	m_slowFrames = 0;
+	m_allocatingTicks = 0;
+	m_tickAllocations = 0;
+	m_pendingStatText.reserve(MAX_STAT_TEXT);
+	gw->setQuality(m_governor.level());
+	gw->setTickTiming(m_options.watchdog);
+}
+
+void GameController::run(int argc, char* argv[], GameWorld* gw, string windowTitle)
+{
+	resetState(gw);
+	m_simThread = thread(&GameController::simulationLoop, this);
 
 	glutInit(&argc, argv);
 
 	glutInitDisplayMode(GLUT_RGB | GLUT_DEPTH | GLUT_DOUBLE);
-	glutInitWindowSize(WINDOW_WIDTH, WINDOW_HEIGHT);
+	glutInitWindowSize(m_options.windowWidth, m_options.windowHeight);
 	glutInitWindowPosition(0, 0);
 	glutCreateWindow(windowTitle.c_str());
 
 	initDrawersAndSounds();
+	Framebuffer::loadFunctions([](const char* name) { return reinterpret_cast<void*>(glutGetProcAddress(name)); });
 
 	glutKeyboardFunc(keyboardEventCallback);
 	glutSpecialFunc(specialKeyboardEventCallback);
 	glutReshapeFunc(reshapeCallback);
 	glutDisplayFunc(doSomethingCallback);
-	glutTimerFunc(MS_PER_FRAME, timerFuncCallback, 0);
+	glutTimerFunc(m_options.msPerFrame, timerFuncCallback, 0);
 
 	glutSetOption(GLUT_ACTION_ON_WINDOW_CLOSE, GLUT_ACTION_GLUTMAINLOOP_RETURNS);
 	glutMainLoop();
+	stopSimulationThread();
+	writeProfile();
+	reportInputLatency();
+	reportWatchdog();
+	reportAllocationCheck();
 	delete m_gw;
 }
 
+  // Plays the game with no window, rendering each tick offscreen (with the
+  // same drawing code the window uses, or with the software renderer), and
+  // reports how long simulating and rendering took.  Only every
+  // ticksPerFrame'th tick is rendered.  If dumpPrefix isn't empty, every
+  // dumpEvery'th frame is saved as dumpPrefix + tick number + ".tga".
+int GameController::runHeadless(GameWorld* gw)
+{
+	resetState(gw);
+	const Options& options = m_options;
+	const int width = options.windowWidth;
+	const int height = options.windowHeight;
+
+	OffscreenContext context;
+	unique_ptr<SoftwareRenderer> software;
+	string rendererName;
+	if (options.softwareRenderer)
+	{
+		software.reset(new SoftwareRenderer(width, height, options.threads));
+		if (!loadSprites(*software, m_gw->assetDirectory()))
+		{
+			delete m_gw;
+			return 1;
+		}
+		rendererName = "software";
+	}
+	else
+	{
+		string error;
+		if (!context.create(width, height, error))
+		{
+			cout << error << endl;
+			delete m_gw;
+			return 1;
+		}
+		initDrawersAndSounds();
+		Framebuffer::loadFunctions(OffscreenContext::getProcAddress);
+		reshape(width, height);
+		rendererName = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+	}
+
+	using Clock = chrono::steady_clock;
+	Clock::duration simTime(0);
+	Clock::duration renderTime(0);
+	vector<unsigned char> pixels;
+	int ticks = 0;
+	int frames = 0;
+	int ticksPerFrame = max(1, options.ticksPerFrame);
+	int framesPerSnapshot = 1;
+	if (options.interpolate)
+		framesPerSnapshot = max(1, static_cast<int>(lround(1000 / options.ticksPerSecond / options.msPerFrame)));
+
+	bool playing = (m_gw->init() == GWSTATUS_CONTINUE_GAME);
+	while (playing  &&  ticks < options.headlessTicks)
+	{
+		Clock::time_point start = Clock::now();
+		int status = moveWorld();
+		m_simTick++;
+		ticks++;
+		if (ticks % ticksPerFrame != 0  &&  status == GWSTATUS_CONTINUE_GAME)
+		{
+			Clock::duration d = Clock::now() - start;
+			profileTick(d);
+			simTime += d;
+			continue;
+		}
+		publishSnapshot();
+		Clock::time_point simulated = Clock::now();
+		simTime += simulated - start;
+		profileTick(simulated - start);
+
+		  // With --interpolate, draw as many frames per snapshot as the
+		  // window would, each further along from the previous snapshot
+		m_snapshots.acquireLatest();
+		const RenderSnapshot& snap = m_snapshots.readBuffer();
+		for (int k = 1; k <= framesPerSnapshot; k++)
+		{
+			double blend = double(k) / framesPerSnapshot;
+			Clock::time_point frameStart = Clock::now();
+			if (software)
+			{
+				software->beginFrame();
+				plotSnapshot(*software, snap, blend);
+				software->endFrame();
+			}
+			else
+			{
+				drawGamePlay(snap, blend);
+				glFinish();
+			}
+			Clock::duration d = Clock::now() - frameStart;
+			renderTime += d;
+			profileFrame(d);
+			governQuality(d);
+			frames++;
+
+			if (!options.dumpPrefix.empty()  &&  options.dumpEvery > 0  &&  frames % options.dumpEvery == 0)
+			{
+				if (software)
+					pixels = software->pixels();
+				else
+					context.readPixels(pixels);
+				ostringstream filename;
+				filename << options.dumpPrefix << setw(6) << setfill('0') << ticks;
+				if (framesPerSnapshot > 1)
+					filename << '-' << k;
+				filename << ".tga";
+				if (!writeTGA(filename.str(), width, height, pixels))
+					cout << "Cannot write " << filename.str() << endl;
+			}
+		}
+
+		if (status == GWSTATUS_PLAYER_DIED  ||  status == GWSTATUS_FINISHED_LEVEL)
+		{
+			if (status == GWSTATUS_FINISHED_LEVEL)
+			{
+				if (options.actorStats)
+					m_gw->describeActors(cout);
+				m_gw->advanceToNextLevel();
+			}
+			m_gw->cleanUp();
+			playing = !m_gw->isGameOver()  &&  m_gw->init() == GWSTATUS_CONTINUE_GAME;
+		}
+	}
+	m_gw->cleanUp();
+
+	double simMs = chrono::duration<double, milli>(simTime).count();
+	double renderMs = chrono::duration<double, milli>(renderTime).count();
+	cout << "Headless: " << ticks << " ticks, " << frames << " frames at " << width << "x" << height
+		 << " (" << rendererName << ")" << endl;
+	if (ticks > 0)
+		cout << "  simulate: " << simMs / ticks << " ms/tick, "
+			 << (simMs > 0 ? ticks * 1000 / simMs : 0) << " ticks/s" << endl;
+	if (frames > 0)
+		cout << "  render:   " << renderMs / frames << " ms/frame, "
+			 << (renderMs > 0 ? frames * 1000 / renderMs : 0) << " fps" << endl;
+
+	if (m_governor.isAutomatic())
+		cout << "  quality:  level " << m_governor.level() << " at the end, " << m_governor.changes() << " changes" << endl;
+
+	writeProfile();
+	reportInputLatency();
+	reportWatchdog();
+	reportAllocationCheck();
+	delete m_gw;
+	return m_allocatingTicks > 0 ? 1 : 0;
+}
+
+  // Runs one tick of the world.  With --alloc-check, every tick after the
+  // warm-up is expected to leave the heap alone.
+int GameController::moveWorld()
+{
+	unsigned long tick = m_gw->getTick();
+	bool checking = m_options.allocCheck  &&  tick >= static_cast<unsigned long>(m_options.allocCheckWarmup);
+	unsigned long before = allocationCount();
+	armAllocationCheck(checking);
+	int status = m_gw->move();
+	armAllocationCheck(false);
+	unsigned long allocations = allocationCount() - before;
+	if (checking  &&  allocations > 0)
+		reportTickAllocations(tick, allocations);
+	return status;
+}
+
+void GameController::simulationLoop()
+{
+	auto nextTick = chrono::steady_clock::now();
+	for (;;)
+	{
+		{
+			unique_lock<mutex> lock(m_simMutex);
+			if (!m_simRunning && !m_simQuit)
+			{
+				m_simCV.wait(lock, [this] { return m_simRunning || m_simQuit; });
+				nextTick = chrono::steady_clock::now();
+			}
+			if (m_simQuit)
+				return;
+		}
+
+		  // In single-step mode, each key hit advances the game by one tick
+		int key;
+		if (m_singleStep  &&  !getLastKey(key))
+		{
+			this_thread::sleep_for(chrono::milliseconds(m_options.msPerFrame));
+			continue;
+		}
+
+		  // In turbo mode, several ticks go by for each snapshot
+		int ticks = m_singleStep ? 1 : m_ticksPerFrame.load();
+		int status = GWSTATUS_CONTINUE_GAME;
+		for (int k = 0; k < ticks  &&  status == GWSTATUS_CONTINUE_GAME; k++)
+		{
+			auto start = chrono::steady_clock::now();
+			status = moveWorld();
+			profileTick(chrono::steady_clock::now() - start);
+			m_simTick++;
+		}
+		measureTickRate();
+		publishSnapshot();
+
+		if (status != GWSTATUS_CONTINUE_GAME)
+		{
+			lock_guard<mutex> lock(m_simMutex);
+			m_simStatus = status;
+			m_simRunning = false;
+			continue;
+		}
+
+		if (m_unthrottled)
+			nextTick = chrono::steady_clock::now();
+		else
+		{
+			nextTick += m_tickInterval;
+			this_thread::sleep_until(nextTick);
+		}
+	}
+}
+
+void GameController::startSimulation()
+{
+	{
+		lock_guard<mutex> lock(m_simMutex);
+		m_simStatus = GWSTATUS_CONTINUE_GAME;
+		m_simRunning = true;
+	}
+	m_simCV.notify_one();
+}
+
+  // Returns true once the simulation has stopped itself, along with the
+  // status of the tick that stopped it
+bool GameController::simulationStopped(int& status)
+{
+	lock_guard<mutex> lock(m_simMutex);
+	if (m_simRunning)
+		return false;
+	status = m_simStatus;
+	return true;
+}
+
+void GameController::stopSimulationThread()
+{
+	if (!m_simThread.joinable())
+		return;
+	{
+		lock_guard<mutex> lock(m_simMutex);
+		m_simQuit = true;
+	}
+	m_simCV.notify_one();
+	m_simThread.join();
+}
+
+  // Copies what's needed to draw the world into the next render snapshot.
+  // Must only be called by whichever thread currently owns the world.
+void GameController::publishSnapshot()
+{
+	RenderSnapshot& snap = m_snapshots.writeBuffer();
+	snap.tick = m_simTick;
+	snap.items.clear();
+	GraphObject::drawAllObjects(
+		[&snap](int imageID, int animationNumber, double fromX, double fromY, int fromAngle,
+				double x, double y, int angle, double size, int depth)
+		{
+			snap.items.push_back(RenderItem{ imageID, static_cast<unsigned int>(animationNumber),
+				static_cast<float>(fromX), static_cast<float>(fromY), static_cast<float>(x),
+				static_cast<float>(y), static_cast<short>(fromAngle), static_cast<short>(angle),
+				static_cast<unsigned char>(depth), static_cast<float>(size) });
+		});
+	snap.backgroundScroll = m_gw->getBackgroundScroll();
+	snap.backgroundEpoch = m_gw->getBackgroundEpoch();
+	snap.fromBackgroundScroll = (snap.backgroundEpoch == m_publishedBackgroundEpoch ? m_publishedBackgroundScroll
+																				   : snap.backgroundScroll);
+	m_publishedBackgroundScroll = snap.backgroundScroll;
+	m_publishedBackgroundEpoch = snap.backgroundEpoch;
+	snap.published = chrono::steady_clock::now();
+	snap.tickInterval = (m_singleStep  ||  m_unthrottled) ? chrono::steady_clock::duration::zero()
+														   : m_tickInterval;
+	snap.statText = m_pendingStatText;
+	snap.turboText = m_turboText;
+	snap.hasInput = m_hasUnpresentedInput;
+	snap.oldestInput = m_oldestUnpresentedInput;
+	m_hasUnpresentedInput = false;
+	m_snapshots.publish();
+}
+
+  // Keeps m_turboText up to date with the turbo settings and how many ticks
+  // per second the simulation managed over the last second or so.  Must
+  // only be called by the simulation thread.
+void GameController::measureTickRate()
+{
+	int ticksPerFrame = m_ticksPerFrame;
+	bool unthrottled = m_unthrottled;
+	if (ticksPerFrame == 1  &&  !unthrottled)
+	{
+		m_turboText.clear();
+		return;
+	}
+
+	auto now = chrono::steady_clock::now();
+	double seconds = chrono::duration<double>(now - m_rateStart).count();
+	if (seconds >= 1  ||  m_turboText.empty())
+	{
+		ostringstream oss;
+		oss << "Turbo x" << ticksPerFrame << (unthrottled ? " unthrottled" : "");
+		if (!m_turboText.empty())
+			oss << ": " << static_cast<long>((m_simTick - m_rateStartTick) / seconds) << " ticks/s";
+		m_turboText = oss.str();
+		m_rateStart = now;
+		m_rateStartTick = m_simTick;
+	}
+}
+
+void GameController::profileTick(chrono::steady_clock::duration d)
+{
+	if (!m_options.profileFile.empty()  &&  m_tickMicros.size() < MAX_PROFILE_SAMPLES)
+		m_tickMicros.push_back(chrono::duration<float, micro>(d).count());
+	if (m_options.watchdog  &&  d > m_tickBudget)
+		reportSlowTick(d);
+}
+
+void GameController::profileFrame(chrono::steady_clock::duration d)
+{
+	if (!m_options.profileFile.empty()  &&  m_frameMicros.size() < MAX_PROFILE_SAMPLES)
+		m_frameMicros.push_back(chrono::duration<float, micro>(d).count());
+	if (m_options.watchdog  &&  d > m_frameBudget)
+		reportSlowFrame(d);
+}
+
+  // Explains a tick that went over budget.  Called by whichever thread owns
+  // the world, right after the tick, so the world can still say what was
+  // going on.
+void GameController::reportSlowTick(chrono::steady_clock::duration d)
+{
+	if (++m_slowTicks > MAX_WATCHDOG_REPORTS)
+		return;
+	unsigned long tick = m_gw->getTick() - 1;
+	cout << "Slow tick " << tick << " (level " << m_gw->getLevel() << "): "
+		 << chrono::duration<double, milli>(d).count() << " ms, budget "
+		 << chrono::duration<double, milli>(m_tickBudget).count() << " ms" << endl;
+	m_gw->describeTick(cout);
+
+	  // The recording starts from the beginning of the game, since replaying
+	  // is the only way to get the world back into the state it was in
+	if (!m_options.watchdogKeys.empty())
+	{
+		ostringstream filename;
+		filename << m_options.watchdogKeys << tick << ".keys";
+		if (m_gw->saveKeyHistory(filename.str()))
+			cout << "  reproduce with --replay=" << filename.str() << " --headless=" << tick + 1 << endl;
+		else
+			cout << "  Cannot write " << filename.str() << endl;
+	}
+}
+
+void GameController::reportSlowFrame(chrono::steady_clock::duration d)
+{
+	if (++m_slowFrames > MAX_WATCHDOG_REPORTS)
+		return;
+	const RenderSnapshot& snap = m_snapshots.readBuffer();
+	cout << "Slow frame drawing tick " << snap.tick << ": "
+		 << chrono::duration<double, milli>(d).count() << " ms, budget "
+		 << chrono::duration<double, milli>(m_frameBudget).count() << " ms, "
+		 << snap.items.size() << " sprites" << endl;
+}
+
+void GameController::reportWatchdog() const
+{
+	if (m_options.watchdog)
+		cout << "Watchdog: " << m_slowTicks << " slow ticks, " << m_slowFrames << " slow frames" << endl;
+}
+
+  // Feeds the governor each frame's drawing time, and passes on any change
+  // in level.  Called by whichever thread draws.
+void GameController::governQuality(chrono::steady_clock::duration frameTime)
+{
+	int level = m_governor.level();
+	if (m_governor.update(frameTime) != level)
+		applyQuality(m_governor.level());
+}
+
+  // The world reads its level at its own pace; texture filtering has to be
+  // changed by the drawing thread
+void GameController::applyQuality(int level)
+{
+	m_gw->setQuality(level);
+	m_spriteManager.setMipmapFiltering(level >= MIPMAP_MIN_QUALITY);
+}
+
+void GameController::reportTickAllocations(unsigned long tick, unsigned long allocations)
+{
+	m_tickAllocations += allocations;
+	if (++m_allocatingTicks > MAX_WATCHDOG_REPORTS)
+		return;
+	cout << "Tick " << tick << " (level " << m_gw->getLevel() << ") allocated " << allocations
+		 << " times, last " << lastArmedAllocationSize() << " bytes; break on allocatedWhileArmed() to see where" << endl;
+}
+
+void GameController::reportAllocationCheck() const
+{
+	if (m_options.allocCheck)
+		cout << "Allocation check: " << m_allocatingTicks << " ticks after the first " << m_options.allocCheckWarmup
+			 << " allocated, " << m_tickAllocations << " allocations in all" << endl;
+}
+
+  // Saves the profile as CSV, one "kind,index,microseconds" line per sample
+void GameController::writeProfile() const
+{
+	if (m_options.profileFile.empty())
+		return;
+	ofstream out(m_options.profileFile.c_str());
+	if (!out)
+	{
+		cout << "Cannot write " << m_options.profileFile << endl;
+		return;
+	}
+	out << "kind,index,microseconds\n";
+	for (size_t k = 0; k < m_tickMicros.size(); k++)
+		out << "tick," << k << ',' << m_tickMicros[k] << '\n';
+	for (size_t k = 0; k < m_frameMicros.size(); k++)
+		out << "frame," << k << ',' << m_frameMicros[k] << '\n';
+}
+
+  // Profiling also reports how long keys took to reach a tick and the
+  // screen.  Only keys the player hit count; an autopilot's or a
+  // recording's never wait in the input queue.
+void GameController::reportInputLatency() const
+{
+	if (m_options.profileFile.empty()  ||  m_tickLatency.count == 0)
+		return;
+	cout << "Input latency over " << m_tickLatency.count << " keys: "
+		 << m_tickLatency.averageMicros() << "us avg / " << m_tickLatency.maxMicros << "us max to tick, "
+		 << m_presentLatency.averageMicros() << "us avg / " << m_presentLatency.maxMicros << "us max to screen"
+		 << (m_droppedKeys > 0 ? " (some keys were dropped)" : "") << endl;
+}
+
+void GameController::setTurbo(int ticksPerFrame, bool unthrottled)
+{
+	m_ticksPerFrame = max(1, min(ticksPerFrame, MAX_TICKS_PER_FRAME));
+	m_unthrottled = unthrottled;
+}
+
+void GameController::pushKey(int key)
+{
+	if (!m_input.push(InputEvent{ key, InputClock::now() }))
+		m_droppedKeys++;
+}
+
 void GameController::keyboardEvent(unsigned char key, int /* x */, int /* y */)
 {
 	switch (key)
 	{
-		case 'a': case '4': m_lastKeyHit = KEY_PRESS_LEFT;	break;
-		case 'd': case '6': m_lastKeyHit = KEY_PRESS_RIGHT; break;
-		case 'w': case '8': m_lastKeyHit = KEY_PRESS_UP;	break;
-		case 's': case '2': m_lastKeyHit = KEY_PRESS_DOWN;	break;
-		case 't':			m_lastKeyHit = KEY_PRESS_TAB;	break;
-		case 'f':			m_singleStep = true;			break;
-		case 'r':			m_singleStep = false;			break;
-		case 'q': case 'Q': setGameState(quit);				break;
-		default:			m_lastKeyHit = key;				break;
+		case 'a': case '4': pushKey(KEY_PRESS_LEFT);	break;
+		case 'd': case '6': pushKey(KEY_PRESS_RIGHT);	break;
+		case 'w': case '8': pushKey(KEY_PRESS_UP);		break;
+		case 's': case '2': pushKey(KEY_PRESS_DOWN);	break;
+		case 't':			pushKey(KEY_PRESS_TAB);		break;
+		case 'f':			m_singleStep = true;		break;
+		case 'r':			m_singleStep = false;		break;
+		case '+': case '=': setTurbo(m_ticksPerFrame * 2, m_unthrottled);	break;
+		case '-':			setTurbo(m_ticksPerFrame / 2, m_unthrottled);	break;
+		case 'x':			setTurbo(m_ticksPerFrame, !m_unthrottled);		break;
+		case 'q': case 'Q': setGameState(quit);			break;
+		default:			pushKey(key);				break;
 	}
 }
 
@@ -174,11 +752,11 @@ void GameController::specialKeyboardEvent(int key, int /* x */, int /* y */)
 {
 	switch (key)
 	{
-		case GLUT_KEY_LEFT:	 m_lastKeyHit = KEY_PRESS_LEFT;	 break;
-		case GLUT_KEY_RIGHT: m_lastKeyHit = KEY_PRESS_RIGHT; break;
-		case GLUT_KEY_UP:	 m_lastKeyHit = KEY_PRESS_UP;	 break;
-		case GLUT_KEY_DOWN:	 m_lastKeyHit = KEY_PRESS_DOWN;	 break;
-		default:			 m_lastKeyHit = INVALID_KEY;	 break;
+		case GLUT_KEY_LEFT:	 pushKey(KEY_PRESS_LEFT);	break;
+		case GLUT_KEY_RIGHT: pushKey(KEY_PRESS_RIGHT);	break;
+		case GLUT_KEY_UP:	 pushKey(KEY_PRESS_UP);		break;
+		case GLUT_KEY_DOWN:	 pushKey(KEY_PRESS_DOWN);	break;
+		default:										break;
 	}
 }
 
@@ -192,12 +770,7 @@ void GameController::playSound(int soundID)
 
 	SoundMapType::const_iterator p = m_soundMap.find(soundID);
 	if (p != m_soundMap.end())
-	{
-		string path = m_gw->assetDirectory();
-		if (!path.empty())
-			path += '/';
-		SoundFX().playClip(path + p->second);
-	}
+		SoundFX().playClip(p->second);
 }
 
 void GameController::setGameState(GameControllerState s)
@@ -215,13 +788,18 @@ void GameController::setGameStateAfterPrompting(GameControllerState s,
 	setGameState(prompt);
 }
 
+  // May be called from the simulation thread, so just leave a note for the
+  // GLUT thread to act on
 void GameController::quitGame()
 {
-	setGameState(quit);
+	m_quitRequested = true;
 }
 
 void GameController::doSomething()
 {
+	if (m_quitRequested)
+		setGameState(quit);
+
 	switch (m_gameState)
 	{
 		case not_applicable:
@@ -245,39 +823,30 @@ void GameController::doSomething()
 						"Error in level data file encoding!",
 						"Press Enter to quit...");
 				else
-					setGameState(makemove);
-			}
-			break;
-		case makemove:
-			m_curIntraFrameTick = ANIMATION_POSITIONS_PER_TICK;
-			m_nextStateAfterAnimate = not_applicable;
-			{
-				int status = m_gw->move();
-				if (status == GWSTATUS_PLAYER_DIED)
-				{
-					  // animate one last frame so the player can see what happened
-					m_nextStateAfterAnimate = (m_gw->isGameOver() ? gameover : contgame);
-				}
-				else if (status == GWSTATUS_FINISHED_LEVEL)
 				{
-					m_gw->advanceToNextLevel();
-					  // animate one last frame so the player can see what happened
-					m_nextStateAfterAnimate = finishedlevel;
+					publishSnapshot();
+					startSimulation();
+					setGameState(play);
 				}
 			}
-			setGameState(animate);
 			break;
-		case animate:
+		case play:
 			displayGamePlay();
-			if (m_curIntraFrameTick-- <= 0)
 			{
-				if (m_nextStateAfterAnimate != not_applicable)
-					setGameState(m_nextStateAfterAnimate);
-				else
+				int status;
+				if (simulationStopped(status))
 				{
-					int key;
-					if (!m_singleStep  ||  getLastKey(key))
-						setGameState(makemove);
+					  // The last tick has already been drawn, so the player can see what happened
+					if (status == GWSTATUS_PLAYER_DIED)
+						setGameState(m_gw->isGameOver() ? gameover : contgame);
+					else if (status == GWSTATUS_FINISHED_LEVEL)
+					{
+						  // The simulation is stopped, so the world can be read
+						if (m_options.actorStats)
+							m_gw->describeActors(cout);
+						m_gw->advanceToNextLevel();
+						setGameState(finishedlevel);
+					}
 				}
 			}
 			break;
@@ -303,14 +872,21 @@ void GameController::doSomething()
 			}
 			break;
 		case prompt:
-			drawPrompt(m_mainMessage, m_secondMessage);
+			drawPrompt();
 			{
+				  // The autopilot doesn't wait for anyone to read the prompt
 				int key;
-				if (getLastKey(key) && key == '\r')
+				if (m_gw->isAutopilot()  ||  (getLastKey(key) && key == '\r'))
+				{
+					  // Keys hit while the prompt was up aren't meant for the game
+					m_input.clear();
+					m_hasUnpresentedInput = false;
 					setGameState(m_nextStateAfterPrompt);
+				}
 			}
 			break;
 		case quit:
+			stopSimulationThread();
             SoundFX().abortClip();
 			glutLeaveMainLoop();
 			break;
@@ -318,6 +894,26 @@ void GameController::doSomething()
 }
 
 void GameController::displayGamePlay()
+{
+	m_snapshots.acquireLatest();
+	const RenderSnapshot& snap = m_snapshots.readBuffer();
+	auto start = chrono::steady_clock::now();
+	drawGamePlay(snap, m_options.interpolate ? snapshotBlend(snap, start) : 1);
+	auto drawn = chrono::steady_clock::now() - start;
+	profileFrame(drawn);
+	governQuality(drawn);
+
+	glutSwapBuffers();
+
+	if (snap.tick != m_lastPresentedTick)
+	{
+		if (snap.hasInput)
+			m_presentLatency.record(snap.oldestInput, InputClock::now());
+		m_lastPresentedTick = snap.tick;
+	}
+}
+
+void GameController::drawGamePlay(const RenderSnapshot& snap, double blend)
 {
 	glEnable(GL_DEPTH_TEST); // must be done each time before displaying graphics or gets disabled for some reason
 	glLoadIdentity();
@@ -331,17 +927,25 @@ void GameController::displayGamePlay()
 #pragma GCC diagnostic pop
 #endif
 
-    GraphObject::drawAllObjects(
-        [=](int imageID, int animationNumber, double x, double y, int angle, double size)
-        {
-            int frame = animationNumber % m_spriteManager.getNumFrames(imageID);
-            m_spriteManager.plotSprite(imageID, frame, x, y, angle, size);
-            
-        });
-
-	drawScoreAndLives(m_gameStatText);
-
-	glutSwapBuffers();
+	  // The internal resolution has the window's configured shape, as the
+	  // projection does
+	bool upscaled = false;
+	if (m_options.internalHeight > 0)
+	{
+		int width = max(1, static_cast<int>(lround(double(m_options.internalHeight) * m_options.windowWidth / m_options.windowHeight)));
+		upscaled = m_upscaled.begin(width, m_options.internalHeight);
+	}
+	bool cached = m_options.cachedBackground  &&  m_background.draw(m_spriteManager, snap, blend);
+	plotSnapshot(m_spriteManager, snap, blend, cached ? GraphObject::BACKGROUND_DEPTH : -1);
+	if (upscaled)
+		m_upscaled.end();
+	drawScoreAndLives(snap.statText);
+	if (!snap.turboText.empty())
+	{
+		glColor3f(1.0, 1.0, 0.4f);
+		m_turboRun.setText(snap.turboText, m_glyphAtlas);
+		m_turboRun.drawCentered(m_glyphAtlas, TURBO_Y, SCORE_Z, TEXT_HEIGHT);
+	}
 }
 
 void GameController::reshape (int w, int h)
@@ -350,63 +954,39 @@ void GameController::reshape (int w, int h)
 	glMatrixMode (GL_PROJECTION);
 	glLoadIdentity ();
 #ifdef _MSC_VER
-	gluPerspective(45.0, double(WINDOW_WIDTH) / WINDOW_HEIGHT, PERSPECTIVE_NEAR_PLANE, PERSPECTIVE_FAR_PLANE);
+	gluPerspective(45.0, double(m_options.windowWidth) / m_options.windowHeight, PERSPECTIVE_NEAR_PLANE, PERSPECTIVE_FAR_PLANE);
 #else
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-	gluPerspective(45.0, double(WINDOW_WIDTH) / WINDOW_HEIGHT, PERSPECTIVE_NEAR_PLANE, PERSPECTIVE_FAR_PLANE);
+	gluPerspective(45.0, double(m_options.windowWidth) / m_options.windowHeight, PERSPECTIVE_NEAR_PLANE, PERSPECTIVE_FAR_PLANE);
 #pragma GCC diagnostic pop
 #endif
 	glMatrixMode (GL_MODELVIEW);
 }
 
-static void doOutputStroke(double x, double y, double z, double size, const char* str, bool centered)
-{
-	if (centered)
-	{
-		double len = glutStrokeLength(GLUT_STROKE_ROMAN, reinterpret_cast<const unsigned char*>(str)) / FONT_SCALEDOWN;
-		x = -len / 2;
-		size = 1;
-	}
-	GLfloat scaledSize = static_cast<GLfloat>(size / FONT_SCALEDOWN);
-	glPushMatrix();
-	glLineWidth(1);
-	glLoadIdentity();
-	glTranslatef(static_cast<GLfloat>(x), static_cast<GLfloat>(y), static_cast<GLfloat>(z));
-	glScalef(scaledSize, scaledSize, scaledSize);
-	for ( ; *str != '\0'; str++)
-		glutStrokeCharacter(GLUT_STROKE_ROMAN, *str);
-	glPopMatrix();
-}
-
-//static void outputStroke(double x, double y, double z, double size, const char* str)
-//{
-//	doOutputStroke(x, y, z, size, str, false);
-//}
-
-static void outputStrokeCentered(double y, double z, const char* str)
-{
-	doOutputStroke(0, y, z, 1, str, true);
-}
-
-static void drawPrompt(string mainMessage, string secondMessage)
+void GameController::drawPrompt()
 {
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 	glColor3f (1.0, 1.0, 1.0);
 	glLoadIdentity ();
-	outputStrokeCentered(1, -5, mainMessage.c_str());
-	outputStrokeCentered(-1, -5, secondMessage.c_str());
+	m_mainMessageText.setText(m_mainMessage, m_glyphAtlas);
+	m_secondMessageText.setText(m_secondMessage, m_glyphAtlas);
+	m_mainMessageText.drawCentered(m_glyphAtlas, 1, -5, TEXT_HEIGHT);
+	m_secondMessageText.drawCentered(m_glyphAtlas, -1, -5, TEXT_HEIGHT);
 	glutSwapBuffers();
 }
 
-static void drawScoreAndLives(string gameStatText)
+void GameController::drawScoreAndLives(const string& gameStatText)
 {
-	static int RATE = 1;
+	  // The flicker has its own generator so drawing never touches the
+	  // simulation's randInt() from the render thread
+	static minstd_rand flicker;
+	static uniform_int_distribution<> nudge(-1, 1);
 	static GLfloat rgb[3] =
 		{ static_cast<GLfloat>(.6), static_cast<GLfloat>(.6), static_cast<GLfloat>(.6) };
 	for (int k = 0; k < 3; k++)
 	{
-		double strength = rgb[k] + randInt(-RATE, RATE) / 100.0;
+		double strength = rgb[k] + nudge(flicker) / 100.0;
 		if (strength < .6)
 			strength = .6;
 		else if (strength > 1.0)
@@ -414,5 +994,6 @@ static void drawScoreAndLives(string gameStatText)
 		rgb[k] = static_cast<GLfloat>(strength);
 	}
 	glColor3f(rgb[0], rgb[1], rgb[2]);
-	outputStrokeCentered(SCORE_Y, SCORE_Z, gameStatText.c_str());
+	m_statText.setText(gameStatText, m_glyphAtlas);
+	m_statText.drawCentered(m_glyphAtlas, SCORE_Y, SCORE_Z, TEXT_HEIGHT);
 }
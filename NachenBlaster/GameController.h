@@ -2,12 +2,27 @@
 #define GAMECONTROLLER_H_
 
 #include "SpriteManager.h"
+#include "BackgroundLayer.h"
+#include "UpscaledTarget.h"
+#include "GlyphAtlas.h"
+#include "InputQueue.h"
+#include "RenderSnapshot.h"
+#include "Options.h"
+#include "QualityGovernor.h"
 #include <string>
 #include <map>
 #include <iostream>
 #include <sstream>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <vector>
 
 const int INVALID_KEY = 0;
+const int INPUT_QUEUE_SIZE = 1024;
+const int MAX_TICKS_PER_FRAME = 64;
 
 class GraphObject;
 class GameWorld;
@@ -15,34 +30,64 @@ class GameWorld;
 class GameController
 {
   public:
+	  // Must be called before run() or runHeadless()
+	void configure(const Options& options);
+
 	void run(int argc, char* argv[], GameWorld* gw, std::string windowTitle);
+	int runHeadless(GameWorld* gw);
 
+	  // Takes the oldest key press that hasn't been handled yet.  Every key
+	  // hit is queued, so calling this until it returns false drains all of
+	  // the input that arrived since the last tick.
 	bool getLastKey(int& value)
 	{
-		if (m_lastKeyHit != INVALID_KEY)
+		InputEvent e;
+		if (!m_input.pop(e))
+			return false;
+		value = e.key;
+		m_tickLatency.record(e.arrival, InputClock::now());
+		if (!m_hasUnpresentedInput)
 		{
-			value = m_lastKeyHit;
-			m_lastKeyHit = INVALID_KEY;
-			return true;
+			m_oldestUnpresentedInput = e.arrival;
+			m_hasUnpresentedInput = true;
 		}
-		return false;
+		return true;
 	}
 
+	  // Time from a key arriving to the tick that handled it, and to the
+	  // first frame presented after that tick
+	const InputLatency& getTickLatency() const	 { return m_tickLatency; }
+	const InputLatency& getPresentLatency() const { return m_presentLatency; }
+	long long getDroppedKeys() const			 { return m_droppedKeys; }
+
 	void playSound(int soundID);
 
-	void setGameStatText(std::string text)
+	  // Called by the world during a tick; the text goes out with that
+	  // tick's render snapshot.  Copying into the same string every time
+	  // reuses its storage.
+	void setGameStatText(const std::string& text)
 	{
-		m_gameStatText = text;
+		m_pendingStatText = text;
 	}
 
 	void doSomething();
 
+	int getMsPerFrame() const
+	{
+		return m_options.msPerFrame;
+	}
+
 	void reshape(int w, int h);
 	void keyboardEvent(unsigned char key, int x, int y);
 	void specialKeyboardEvent(int key, int x, int y);
 
 	void quitGame();
 
+	  // Turbo mode: the simulation runs ticksPerFrame ticks for every frame
+	  // it hands the renderer, and if unthrottled, runs them as fast as it can
+	  // instead of at the normal pace.  Can be changed while the game runs.
+	void setTurbo(int ticksPerFrame, bool unthrottled);
+
 	  // Meyers singleton pattern
 	static GameController& getInstance()
 	{
@@ -53,28 +98,112 @@ class GameController
 private:
 	enum GameControllerState : int;
 
+	GameController()
+	 : m_ticksPerFrame(1), m_unthrottled(false)
+	{
+		configure(Options());
+	}
+
+	Options		m_options;
+	std::chrono::steady_clock::duration m_tickInterval;
 	GameWorld*	m_gw;
 	GameControllerState	m_gameState;
 	GameControllerState	m_nextStateAfterPrompt;
-	GameControllerState	m_nextStateAfterAnimate;
-	int			m_lastKeyHit;
-	bool		m_singleStep;
-	std::string m_gameStatText;
+	SpscRing<InputEvent, INPUT_QUEUE_SIZE> m_input;
+	InputLatency m_tickLatency;
+	InputLatency m_presentLatency;
+	InputClock::time_point m_oldestUnpresentedInput;
+	bool		m_hasUnpresentedInput;
+	long long	m_droppedKeys;
+	std::atomic<bool> m_singleStep;
+	std::atomic<bool> m_quitRequested;
+	std::string m_pendingStatText;
 	std::string m_mainMessage;
 	std::string m_secondMessage;
-	int			m_curIntraFrameTick;
-	using SoundMapType = std::map<int, std::string>;
+	unsigned long m_lastPresentedTick;
+	double		m_publishedBackgroundScroll;  // as of the last snapshot published
+	unsigned int m_publishedBackgroundEpoch;
+	using SoundMapType = std::map<int, std::string>;  // full paths, so playing one builds no strings
 	using DrawMapType =  std::map<int, std::string>;
 	SoundMapType  m_soundMap;
 	bool		  m_playerWon;
 	SpriteManager m_spriteManager;
+	BackgroundLayer m_background;
+	UpscaledTarget m_upscaled;
+	GlyphAtlas	  m_glyphAtlas;
+	TextRun		  m_statText;
+	TextRun		  m_mainMessageText;
+	TextRun		  m_secondMessageText;
 
 	void setGameState(GameControllerState s);
 	void setGameStateAfterPrompting(GameControllerState s,
 							std::string mainMessage, std::string secondMessage);
 
+	  // The world is simulated on its own thread so a slow tick never holds
+	  // up drawing (and vice versa).  The GLUT thread only touches the world
+	  // while the simulation is stopped, between levels and lives.
+	std::thread				m_simThread;
+	std::mutex				m_simMutex;
+	std::condition_variable m_simCV;
+	bool					m_simRunning;
+	bool					m_simQuit;
+	int						m_simStatus;
+	unsigned long			m_simTick;
+	TripleBuffer<RenderSnapshot> m_snapshots;
+
+	  // Turbo settings, and the tick rate the simulation thread measured
+	std::atomic<int>		m_ticksPerFrame;
+	std::atomic<bool>		m_unthrottled;
+	std::chrono::steady_clock::time_point m_rateStart;
+	unsigned long			m_rateStartTick;
+	std::string				m_turboText;
+	TextRun					m_turboRun;
+
+	  // Timings for --profile, in microseconds.  Each is only touched by one
+	  // thread while the game runs.
+	std::vector<float>		m_tickMicros;
+	std::vector<float>		m_frameMicros;
+
+	  // The watchdog's budgets, and how many ticks and frames went over them
+	std::chrono::steady_clock::duration m_tickBudget;
+	std::chrono::steady_clock::duration m_frameBudget;
+	long					m_slowTicks;
+	long					m_slowFrames;
+
+	  // For --alloc-check: ticks past the warm-up that allocated, and how
+	  // many allocations they made between them
+	long					m_allocatingTicks;
+	unsigned long			m_tickAllocations;
+
+	  // Lowers the world's cosmetic detail while frames run over budget
+	QualityGovernor			m_governor;
+
+	int moveWorld();
+	void simulationLoop();
+	void startSimulation();
+	bool simulationStopped(int& status);
+	void stopSimulationThread();
+	void publishSnapshot();
+	void measureTickRate();
+	void profileTick(std::chrono::steady_clock::duration d);
+	void profileFrame(std::chrono::steady_clock::duration d);
+	void writeProfile() const;
+	void reportInputLatency() const;
+	void reportSlowTick(std::chrono::steady_clock::duration d);
+	void reportSlowFrame(std::chrono::steady_clock::duration d);
+	void reportWatchdog() const;
+	void governQuality(std::chrono::steady_clock::duration frameTime);
+	void applyQuality(int level);
+	void reportTickAllocations(unsigned long tick, unsigned long allocations);
+	void reportAllocationCheck() const;
+
+	void pushKey(int key);
+	void resetState(GameWorld* gw);
 	void initDrawersAndSounds();
 	void displayGamePlay();
+	void drawGamePlay(const RenderSnapshot& snap, double blend);
+	void drawScoreAndLives(const std::string& gameStatText);
+	void drawPrompt();
 };
 
 inline GameController& Game()
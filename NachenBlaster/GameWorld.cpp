@@ -6,22 +6,49 @@ using namespace std;
 
 bool GameWorld::getKey(int& value)
 {
-	bool gotKey = m_controller->getLastKey(value);
+	if (m_keys.isPlaying())
+	{
+		  // Only the recording moves the Blaster, but the player can still quit
+		int key;
+		while (m_controller != nullptr  &&  m_controller->getLastKey(key))
+		{
+			if (key == 'q'  ||  key == '\x03')  // CTRL-C
+				m_controller->quitGame();
+		}
+		return m_keys.nextKey(m_tick, value);
+	}
 
-	if (gotKey)
+	bool gotKey;
+	if (m_nextInjectedKey < m_injectedKeys.size())
+	{
+		value = m_injectedKeys[m_nextInjectedKey++];
+		gotKey = true;
+	}
+	else
 	{
-		if (value == 'q'  ||  value == '\x03')  // CTRL-C
+		m_injectedKeys.clear();
+		m_nextInjectedKey = 0;
+		gotKey = m_controller != nullptr  &&  m_controller->getLastKey(value);
+		if (gotKey  &&  (value == 'q'  ||  value == '\x03'))  // CTRL-C
 			m_controller->quitGame();
 	}
+
+	if (gotKey  &&  (m_keys.isRecording()  ||  m_keys.isKeepingHistory()))
+		m_keys.record(m_tick, value);
 	return gotKey;
 }
 
+  // A world with no controller (e.g., one of a BatchEnv's) is never seen or
+  // heard, so sounds and text go nowhere
+
 void GameWorld::playSound(int soundID)
 {
-	m_controller->playSound(soundID);
+	if (m_controller != nullptr)
+		m_controller->playSound(soundID);
 }
 
-void GameWorld::setGameStatText(string text)
+void GameWorld::setGameStatText(const string& text)
 {
-	m_controller->setGameStatText(text);
+	if (m_controller != nullptr)
+		m_controller->setGameStatText(text);
 }
@@ -2,9 +2,25 @@
 #define GAMEWORLD_H_
 
 #include "GameConstants.h"
+#include "EventLog.h"
+#include "KeyRecording.h"
+#include "WorldTrace.h"
+#include <atomic>
+#include <iosfwd>
 #include <string>
+#include <vector>
 
 const int START_PLAYER_LIVES = 3;
+const int MAX_INJECTED_KEYS = 16;  // per tick, before injectKey() has to allocate
+
+  // How much purely cosmetic work the world should do, from the least
+  // (when frames are taking too long) to everything
+const int QUALITY_MIN = 0;
+const int QUALITY_MAX = 3;
+
+  // New background objects (see GameWorld::scrollBackground) may not start
+  // out left of this
+const double BACKGROUND_ENTRY_X = VIEW_WIDTH - 1;
 
 class GameController;
 
@@ -14,8 +30,10 @@ public:
 
 	GameWorld(std::string assetDir)
 	 : m_lives(START_PLAYER_LIVES), m_score(0), m_level(1),
-	   m_controller(nullptr), m_assetDir(assetDir)
+	   m_controller(nullptr), m_assetDir(assetDir), m_tick(0), m_autopilot(false), m_tickTiming(false), m_quality(QUALITY_MAX),
+	   m_backgroundScroll(0), m_backgroundEpoch(0), m_nextInjectedKey(0)
 	{
+		m_injectedKeys.reserve(MAX_INJECTED_KEYS);
 	}
 
 	virtual ~GameWorld()
@@ -26,9 +44,33 @@ public:
 	virtual int move() = 0;
 	virtual void cleanUp() = 0;
 
-	void setGameStatText(std::string text);
+	  // Writes whatever the world can say about the tick that just ran (e.g.,
+	  // for the tick watchdog to explain a slow one)
+	virtual void describeTick(std::ostream& /* out */) const
+	{
+	}
+
+	  // Writes whatever the world counts about its objects (e.g., how many
+	  // are alive), for --actor-stats at the end of each level
+	virtual void describeActors(std::ostream& /* out */) const
+	{
+	}
+
+	void setGameStatText(const std::string& text);
 
 	bool getKey(int& value);
+
+	  // Keys injected by the program itself (e.g., by an autopilot) come out
+	  // of getKey() ahead of any the player hit
+	void injectKey(int value)
+	{
+		m_injectedKeys.push_back(value);
+	}
+
+	bool isAutopilot() const
+	{
+		return m_autopilot;
+	}
 	void playSound(int soundID);
 
 	unsigned int getLevel() const
@@ -60,6 +102,101 @@ public:
 	{
 		m_score += howMuch;
 	}
+
+	  // Events go nowhere unless the framework opened a log
+	void recordEvent(GameEventType type, int subject, int value, double x, double y)
+	{
+		m_eventLog.record(m_tick, type, m_level, subject, value, x, y);
+	}
+
+	  // Set by the framework when it wants each tick timed phase by phase
+	  // for describeTick()
+	void setTickTiming(bool on)
+	{
+		m_tickTiming = on;
+	}
+
+	bool isTickTiming() const
+	{
+		return m_tickTiming;
+	}
+
+	  // Keeps every key handled in memory, so a recording that replays the
+	  // game up to the current tick can be saved at any point
+	void keepKeyHistory(unsigned int seed)
+	{
+		m_keys.keepHistory(seed);
+	}
+
+	bool saveKeyHistory(std::string filename) const
+	{
+		return m_keys.saveHistory(filename);
+	}
+
+	  // Set by the framework (e.g., by its quality governor) from any thread.
+	  // The world may only use it to decide things nobody could tell apart
+	  // in a trace: how many stars there are, whether explosions are shown.
+	void setQuality(int level)
+	{
+		m_quality = level;
+	}
+
+	int getQuality() const
+	{
+		return m_quality;
+	}
+
+	  // Everything at the back depth (see GraphObject::BACKGROUND_DEPTH) is
+	  // the background.  Once drawn, it may only move by all of it scrolling
+	  // left together, and the world must say how far it scrolled each tick,
+	  // so the renderer can keep it as one image and just slide that along.
+	  // Objects may join it only at BACKGROUND_ENTRY_X or further right,
+	  // except right after restartBackground(), which says it was replaced
+	  // outright (e.g., at the start of a level).
+	void scrollBackground(double dx)
+	{
+		m_backgroundScroll += dx;
+	}
+
+	void restartBackground()
+	{
+		m_backgroundScroll = 0;
+		m_backgroundEpoch++;
+	}
+
+	double getBackgroundScroll() const
+	{
+		return m_backgroundScroll;
+	}
+
+	unsigned int getBackgroundEpoch() const
+	{
+		return m_backgroundEpoch;
+	}
+
+	  // The world should dump its state into the trace at the end of every
+	  // tick if the framework opened one
+	bool isTracing() const
+	{
+		return m_trace.isOpen();
+	}
+
+	WorldTrace& trace()
+	{
+		return m_trace;
+	}
+
+	unsigned long getTick() const
+	{
+		return m_tick;
+	}
+
+	  // Must be called at the end of every tick; key recordings and the event
+	  // log are keyed by tick
+	void endTick()
+	{
+		m_tick++;
+	}
 	
 	  // The following should be used by only the framework, not the student
 
@@ -72,16 +209,60 @@ public:
 	{
 		++m_level;
 	}
+
+	  // Starts a new game in the same world, from the first level with no
+	  // score.  The world must already be cleaned up, and should be
+	  // initialized again afterward.
+	void restartGame()
+	{
+		m_lives = START_PLAYER_LIVES;
+		m_score = 0;
+		m_level = 1;
+		m_tick = 0;
+		m_injectedKeys.clear();
+		m_nextInjectedKey = 0;
+	}
    
 	void setController(GameController* controller)
 	{
 		m_controller = controller;
 	}
 
+	bool hasController() const
+	{
+		return m_controller != nullptr;
+	}
+
 	std::string assetDirectory() const
 	{
 		return m_assetDir;
 	}
+
+	bool openEventLog(std::string filename)
+	{
+		return m_eventLog.open(filename);
+	}
+
+	bool openTrace(std::string filename)
+	{
+		return m_trace.open(filename);
+	}
+
+	void setAutopilot(bool on)
+	{
+		m_autopilot = on;
+	}
+
+	bool startRecording(std::string filename, unsigned int seed)
+	{
+		return m_keys.startRecording(filename, seed);
+	}
+
+	  // The recording's seed must be used for the replay to match
+	bool startPlayback(std::string filename, unsigned int& seed)
+	{
+		return m_keys.startPlayback(filename, seed);
+	}
 	
 private:
 	unsigned int	m_lives;
@@ -89,6 +270,17 @@ private:
 	unsigned int	m_level;
 	GameController* m_controller;
 	std::string		m_assetDir;
+	EventLog		m_eventLog;
+	KeyRecording	m_keys;
+	WorldTrace		m_trace;
+	unsigned long	m_tick;
+	bool			m_autopilot;
+	bool			m_tickTiming;
+	std::atomic<int> m_quality;
+	double			m_backgroundScroll;
+	unsigned int	m_backgroundEpoch;
+	std::vector<int> m_injectedKeys;
+	std::size_t		m_nextInjectedKey;
 };
 
 #endif // GAMEWORLD_H_
@@ -0,0 +1,354 @@
+#include "GlyphAtlas.h"
+#include <algorithm>
+using namespace std;
+
+  // The printable ASCII characters, one row of pixels per entry with the
+  // leftmost pixel in the high bit.  Rasterized from DejaVu Sans Mono Bold
+  // (Copyright (c) 2003 Bitstream, Inc.; Bitstream Vera license, see
+  // https://dejavu-fonts.github.io/License.html).
+
+static const int NUM_GLYPHS = GlyphAtlas::LAST_CHAR - GlyphAtlas::FIRST_CHAR + 1;
+
+static const unsigned short FONT_GLYPHS[NUM_GLYPHS][GlyphAtlas::GLYPH_HEIGHT] = {
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+	  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// ' '
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0,
+	  0x03c0, 0x03c0, 0x0000, 0x0000, 0x0000, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// '!'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x1c70, 0x1c70, 0x1c70, 0x1c70, 0x1c70, 0x1c70, 0x1c70, 0x0000, 0x0000, 0x0000,
+	  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// '"'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x038e, 0x039c, 0x039c, 0x071c, 0x071c, 0x7fff, 0x7fff, 0x7fff, 0x0e38, 0x0e70,
+	  0x0c70, 0xfffe, 0xfffe, 0xfffe, 0x18e0, 0x38e0, 0x38e0, 0x39c0, 0x31c0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// '#'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0180, 0x0180, 0x0180, 0x07f0, 0x1ff8, 0x1ff8, 0x3d88, 0x3980, 0x3980, 0x3f80, 0x1fe0,
+	  0x1ff8, 0x07f8, 0x01fc, 0x019c, 0x019c, 0x31bc, 0x3ff8, 0x3ff8, 0x0fe0, 0x0180, 0x0180, 0x0180, 0x0180, 0x0000, 0x0000, 0x0000, },	// '$'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x3c00, 0x7e00, 0xe700, 0xc300, 0xc300, 0xe700, 0x7e04, 0x3c38, 0x00e0, 0x0380,
+	  0x0c00, 0x7078, 0x40fc, 0x01ce, 0x0186, 0x0186, 0x01ce, 0x00fc, 0x0078, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// '%'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x07e0, 0x0ff0, 0x1ff0, 0x1e10, 0x1e00, 0x0e00, 0x0f00, 0x0780, 0x1f80, 0x3fc7,
+	  0x39e7, 0x79e7, 0x78f7, 0x787e, 0x7c7e, 0x7e3c, 0x3ffe, 0x1ffe, 0x0fcf, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// '&'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0380, 0x0380, 0x0380, 0x0380, 0x0380, 0x0380, 0x0380, 0x0000, 0x0000, 0x0000,
+	  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// '''
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0070, 0x00e0, 0x00e0, 0x01c0, 0x01c0, 0x03c0, 0x03c0, 0x0780, 0x0780, 0x0780, 0x0780,
+	  0x0780, 0x0780, 0x0780, 0x0780, 0x0780, 0x03c0, 0x03c0, 0x01c0, 0x01c0, 0x00e0, 0x00e0, 0x0070, 0x0000, 0x0000, 0x0000, 0x0000, },	// '('
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0e00, 0x0700, 0x0700, 0x0780, 0x0380, 0x03c0, 0x03c0, 0x01c0, 0x01e0, 0x01e0, 0x01e0,
+	  0x01e0, 0x01e0, 0x01e0, 0x01e0, 0x01c0, 0x03c0, 0x03c0, 0x0380, 0x0780, 0x0700, 0x0700, 0x0e00, 0x0000, 0x0000, 0x0000, 0x0000, },	// ')'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0180, 0x0180, 0x1188, 0x3dbc, 0x1ff8, 0x07e0, 0x07e0, 0x1ff8, 0x3dbc, 0x1188,
+	  0x0180, 0x0180, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// '*'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0380, 0x0380, 0x0380, 0x0380, 0x0380, 0x7ffc,
+	  0x7ffc, 0x7ffc, 0x0380, 0x0380, 0x0380, 0x0380, 0x0380, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// '+'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+	  0x0000, 0x0000, 0x0000, 0x0000, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x0380, 0x0780, 0x0700, 0x0000, 0x0000, 0x0000, 0x0000, },	// ','
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0ff0,
+	  0x0ff0, 0x0ff0, 0x0ff0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// '-'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+	  0x0000, 0x0000, 0x0000, 0x0000, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// '.'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x001c, 0x0038, 0x0038, 0x0070, 0x0070, 0x00e0, 0x00e0, 0x01c0, 0x01c0, 0x0380,
+	  0x0380, 0x0380, 0x0700, 0x0700, 0x0e00, 0x0e00, 0x1c00, 0x1c00, 0x3800, 0x3800, 0x7000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// '/'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x03e0, 0x0ff8, 0x0ff8, 0x1e3c, 0x1e3c, 0x3c1e, 0x3c1e, 0x3c1e, 0x3dde, 0x3dde,
+	  0x3dde, 0x3c1e, 0x3c1e, 0x3c1e, 0x1e3c, 0x1e3c, 0x0ff8, 0x0ff8, 0x03e0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// '0'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x07e0, 0x1fe0, 0x1fe0, 0x19e0, 0x01e0, 0x01e0, 0x01e0, 0x01e0, 0x01e0, 0x01e0,
+	  0x01e0, 0x01e0, 0x01e0, 0x01e0, 0x01e0, 0x01e0, 0x1ffe, 0x1ffe, 0x1ffe, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// '1'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0fe0, 0x3ff8, 0x3ffc, 0x303e, 0x001e, 0x001e, 0x001e, 0x003c, 0x0038, 0x0078,
+	  0x00f0, 0x01e0, 0x03c0, 0x0780, 0x0f00, 0x1e00, 0x3ffe, 0x3ffe, 0x3ffe, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// '2'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x07f0, 0x1ffc, 0x1ffc, 0x103e, 0x001e, 0x001e, 0x003c, 0x07f8, 0x07e0, 0x07f8,
+	  0x003c, 0x001e, 0x001e, 0x001e, 0x001e, 0x303e, 0x3ffc, 0x3ff8, 0x0fe0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// '3'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0078, 0x00f8, 0x00f8, 0x01f8, 0x03f8, 0x03f8, 0x0778, 0x0e78, 0x0e78, 0x1c78,
+	  0x1c78, 0x3878, 0x3ffe, 0x3ffe, 0x3ffe, 0x0078, 0x0078, 0x0078, 0x0078, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// '4'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x1ffc, 0x1ffc, 0x1ffc, 0x1e00, 0x1e00, 0x1e00, 0x1e00, 0x1ff0, 0x1ff8, 0x1ffc,
+	  0x107e, 0x001e, 0x001e, 0x001e, 0x001e, 0x207c, 0x3ffc, 0x3ff8, 0x0fe0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// '5'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x01f8, 0x07fc, 0x0ffc, 0x1f04, 0x1e00, 0x3c00, 0x3df0, 0x3ff8, 0x3ffc, 0x3e3e,
+	  0x3c1e, 0x3c1e, 0x3c1e, 0x3c1e, 0x1c1e, 0x1e3c, 0x1ffc, 0x0ff8, 0x03f0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// '6'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x3ffe, 0x3ffe, 0x3ffe, 0x003e, 0x003c, 0x003c, 0x0078, 0x0078, 0x00f8, 0x00f0,
+	  0x01f0, 0x01e0, 0x01e0, 0x03e0, 0x03c0, 0x07c0, 0x0780, 0x0780, 0x0f80, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// '7'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x07f0, 0x0ff8, 0x1ffc, 0x3e3e, 0x3c1e, 0x3c1e, 0x3c1e, 0x1e3c, 0x0ff8, 0x03e0,
+	  0x0ff8, 0x1e3c, 0x3c1e, 0x3c1e, 0x3c1e, 0x3e3e, 0x1ffc, 0x0ff8, 0x07f0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// '8'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x07e0, 0x0ff8, 0x1ffc, 0x1e3c, 0x3c1c, 0x3c1e, 0x3c1e, 0x3c1e, 0x3c1e, 0x3e3e,
+	  0x1ffe, 0x1ffe, 0x07de, 0x001e, 0x003c, 0x107c, 0x1ff8, 0x1ff0, 0x0fc0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// '9'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0,
+	  0x0000, 0x0000, 0x0000, 0x0000, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// ':'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0,
+	  0x0000, 0x0000, 0x0000, 0x0000, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x0380, 0x0780, 0x0700, 0x0000, 0x0000, 0x0000, 0x0000, },	// ';'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0004, 0x003c, 0x00fc, 0x03f8, 0x1fe0, 0x7f00,
+	  0x7c00, 0x7c00, 0x7f00, 0x1fe0, 0x03f8, 0x00fc, 0x003c, 0x0004, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// '<'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x7ffc, 0x7ffc, 0x7ffc, 0x0000,
+	  0x0000, 0x0000, 0x7ffc, 0x7ffc, 0x7ffc, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// '='
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x4000, 0x7800, 0x7e00, 0x3f80, 0x0ff0, 0x01fc,
+	  0x007c, 0x007c, 0x01fc, 0x0ff0, 0x3f80, 0x7e00, 0x7800, 0x4000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// '>'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x07e0, 0x1ff8, 0x1ffc, 0x103c, 0x003c, 0x007c, 0x00f8, 0x01f0, 0x01c0, 0x03c0,
+	  0x03c0, 0x03c0, 0x03c0, 0x0000, 0x0000, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// '?'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x03f0, 0x0ff8, 0x1e1c, 0x380e, 0x780e, 0x71ee, 0x73fe, 0xe39e, 0xe70e,
+	  0xe70e, 0xe70e, 0xe70e, 0xe70e, 0xe70e, 0xe39e, 0x73fe, 0x71ee, 0x3800, 0x3c00, 0x1e0c, 0x0ffe, 0x03f8, 0x0000, 0x0000, 0x0000, },	// '@'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x07c0, 0x07c0, 0x0fc0, 0x0ee0, 0x0ee0, 0x0ee0, 0x1ef0, 0x1ef0, 0x1c70, 0x1c70,
+	  0x3c78, 0x3ff8, 0x3ff8, 0x7ffc, 0x783c, 0x783c, 0x701c, 0xf01e, 0xf01e, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'A'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x3fe0, 0x3ff8, 0x3ffc, 0x3c3c, 0x3c3c, 0x3c3c, 0x3c3c, 0x3ff8, 0x3fc0, 0x3ff8,
+	  0x3c3c, 0x3c1e, 0x3c1e, 0x3c1e, 0x3c1e, 0x3c3e, 0x3ffc, 0x3ffc, 0x3ff0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'B'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x01f8, 0x07fc, 0x0ffc, 0x1f0c, 0x1e04, 0x3e00, 0x3c00, 0x3c00, 0x3c00, 0x3c00,
+	  0x3c00, 0x3c00, 0x3c00, 0x3e00, 0x1e04, 0x1f0c, 0x0ffc, 0x07fc, 0x01f8, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'C'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x3fc0, 0x3ff0, 0x3ff8, 0x3c7c, 0x3c3c, 0x3c1e, 0x3c1e, 0x3c1e, 0x3c1e, 0x3c1e,
+	  0x3c1e, 0x3c1e, 0x3c1e, 0x3c1e, 0x3c3c, 0x3c7c, 0x3ff8, 0x3ff0, 0x3fc0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'D'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x3ffc, 0x3ffc, 0x3ffc, 0x3c00, 0x3c00, 0x3c00, 0x3c00, 0x3ff8, 0x3ff8, 0x3ff8,
+	  0x3c00, 0x3c00, 0x3c00, 0x3c00, 0x3c00, 0x3c00, 0x3ffc, 0x3ffc, 0x3ffc, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'E'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x3ffc, 0x3ffc, 0x3ffc, 0x3c00, 0x3c00, 0x3c00, 0x3c00, 0x3ff8, 0x3ff8, 0x3ff8,
+	  0x3c00, 0x3c00, 0x3c00, 0x3c00, 0x3c00, 0x3c00, 0x3c00, 0x3c00, 0x3c00, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'F'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x01f8, 0x07fc, 0x0ffc, 0x1f0c, 0x1e00, 0x3e00, 0x3c00, 0x3c00, 0x3c00, 0x3c7e,
+	  0x3c7e, 0x3c7e, 0x3c0e, 0x3e0e, 0x1e0e, 0x1f0e, 0x0ffe, 0x07fe, 0x01f8, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'G'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x3c3c, 0x3c3c, 0x3c3c, 0x3c3c, 0x3c3c, 0x3c3c, 0x3c3c, 0x3ffc, 0x3ffc, 0x3ffc,
+	  0x3c3c, 0x3c3c, 0x3c3c, 0x3c3c, 0x3c3c, 0x3c3c, 0x3c3c, 0x3c3c, 0x3c3c, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'H'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x3ffc, 0x3ffc, 0x3ffc, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0,
+	  0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x3ffc, 0x3ffc, 0x3ffc, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'I'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0ff8, 0x0ff8, 0x0ff8, 0x0078, 0x0078, 0x0078, 0x0078, 0x0078, 0x0078, 0x0078,
+	  0x0078, 0x0078, 0x0078, 0x0078, 0x4078, 0x60f8, 0x7ff0, 0x7ff0, 0x1fc0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'J'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x3c1f, 0x3c1e, 0x3c3c, 0x3c78, 0x3cf8, 0x3cf0, 0x3de0, 0x3fc0, 0x3fe0, 0x3fe0,
+	  0x3ff0, 0x3ef0, 0x3c78, 0x3c78, 0x3c3c, 0x3c3c, 0x3c1e, 0x3c1f, 0x3c0f, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'K'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x1e00, 0x1e00, 0x1e00, 0x1e00, 0x1e00, 0x1e00, 0x1e00, 0x1e00, 0x1e00, 0x1e00,
+	  0x1e00, 0x1e00, 0x1e00, 0x1e00, 0x1e00, 0x1e00, 0x1ffe, 0x1ffe, 0x1ffe, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'L'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x783c, 0x7c7c, 0x7c7c, 0x7c7c, 0x7cfc, 0x7efc, 0x76dc, 0x76dc, 0x77dc, 0x77dc,
+	  0x739c, 0x739c, 0x701c, 0x701c, 0x701c, 0x701c, 0x701c, 0x701c, 0x701c, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'M'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x3e3c, 0x3e3c, 0x3e3c, 0x3e3c, 0x3f3c, 0x3f3c, 0x3f3c, 0x3fbc, 0x3dbc, 0x3dbc,
+	  0x3dbc, 0x3dfc, 0x3cfc, 0x3cfc, 0x3cfc, 0x3c7c, 0x3c7c, 0x3c7c, 0x3c7c, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'N'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x07c0, 0x1ff0, 0x1ff0, 0x3c78, 0x3c78, 0x783c, 0x783c, 0x783c, 0x783c, 0x783c,
+	  0x783c, 0x783c, 0x783c, 0x783c, 0x3c78, 0x3c78, 0x1ff0, 0x1ff0, 0x07c0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'O'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x3fe0, 0x3ff0, 0x3ff8, 0x3c7c, 0x3c3c, 0x3c3c, 0x3c3c, 0x3c3c, 0x3c7c, 0x3ff8,
+	  0x3ff0, 0x3fe0, 0x3c00, 0x3c00, 0x3c00, 0x3c00, 0x3c00, 0x3c00, 0x3c00, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'P'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x07c0, 0x1ff0, 0x1ff0, 0x3c78, 0x3c78, 0x783c, 0x783c, 0x783c, 0x783c, 0x783c,
+	  0x783c, 0x783c, 0x783c, 0x783c, 0x3c78, 0x3c78, 0x1ff0, 0x1ff0, 0x07e0, 0x00f0, 0x0078, 0x0020, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'Q'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x3fe0, 0x3ff8, 0x3ff8, 0x3c7c, 0x3c3c, 0x3c3c, 0x3c3c, 0x3c7c, 0x3ff8, 0x3fe0,
+	  0x3fe0, 0x3cf0, 0x3c78, 0x3c78, 0x3c3c, 0x3c3c, 0x3c1e, 0x3c1e, 0x3c0f, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'R'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x07f0, 0x0ff8, 0x1ff8, 0x3e18, 0x3c08, 0x3c00, 0x3e00, 0x3f80, 0x1fe0, 0x0ff0,
+	  0x03f8, 0x007c, 0x003c, 0x003c, 0x203c, 0x387c, 0x3ff8, 0x3ff8, 0x1fe0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'S'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x7ffe, 0x7ffe, 0x7ffe, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0,
+	  0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'T'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x3c3c, 0x3c3c, 0x3c3c, 0x3c3c, 0x3c3c, 0x3c3c, 0x3c3c, 0x3c3c, 0x3c3c, 0x3c3c,
+	  0x3c3c, 0x3c3c, 0x3c3c, 0x3c3c, 0x3c3c, 0x3e7c, 0x1ff8, 0x0ff0, 0x07e0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'U'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x781e, 0x781e, 0x381c, 0x383c, 0x3c3c, 0x3c3c, 0x1c3c, 0x1c38, 0x1e78, 0x1e78,
+	  0x1e78, 0x0e70, 0x0e70, 0x0ff0, 0x0ff0, 0x07e0, 0x07e0, 0x07e0, 0x07e0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'V'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xe007, 0xe007, 0xf00f, 0xf00f, 0x700e, 0x73ce, 0x73ce, 0x73ce, 0x73ce, 0x73ee,
+	  0x77ee, 0x776e, 0x3e6e, 0x3e6c, 0x3e7c, 0x3e7c, 0x3c3c, 0x3c3c, 0x3c3c, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'W'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xf01e, 0x783c, 0x783c, 0x3c78, 0x1ef0, 0x1ef0, 0x0fe0, 0x0fe0, 0x07c0, 0x07c0,
+	  0x07c0, 0x0fe0, 0x0fe0, 0x1ef0, 0x1c70, 0x3c78, 0x783c, 0x783c, 0xf01e, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'X'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xf00f, 0x781e, 0x781e, 0x3c3c, 0x3c3c, 0x1e78, 0x1e78, 0x0ff0, 0x0ff0, 0x07e0,
+	  0x07e0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'Y'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x3ffe, 0x3ffe, 0x3ffe, 0x003e, 0x003c, 0x0078, 0x00f8, 0x00f0, 0x01e0, 0x03e0,
+	  0x03c0, 0x0780, 0x0f80, 0x0f00, 0x1e00, 0x3c00, 0x3ffe, 0x3ffe, 0x3ffe, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'Z'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x07f0, 0x07f0, 0x0780, 0x0780, 0x0780, 0x0780, 0x0780, 0x0780, 0x0780, 0x0780, 0x0780,
+	  0x0780, 0x0780, 0x0780, 0x0780, 0x0780, 0x0780, 0x0780, 0x0780, 0x0780, 0x0780, 0x07f0, 0x07f0, 0x0000, 0x0000, 0x0000, 0x0000, },	// '['
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x7000, 0x3800, 0x3800, 0x1c00, 0x1c00, 0x0e00, 0x0e00, 0x0600, 0x0700, 0x0300,
+	  0x0380, 0x0180, 0x01c0, 0x00c0, 0x00e0, 0x00e0, 0x0070, 0x0070, 0x0038, 0x0038, 0x001c, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// '\'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0fe0, 0x0fe0, 0x01e0, 0x01e0, 0x01e0, 0x01e0, 0x01e0, 0x01e0, 0x01e0, 0x01e0, 0x01e0,
+	  0x01e0, 0x01e0, 0x01e0, 0x01e0, 0x01e0, 0x01e0, 0x01e0, 0x01e0, 0x01e0, 0x01e0, 0x0fe0, 0x0fe0, 0x0000, 0x0000, 0x0000, 0x0000, },	// ']'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x03c0, 0x07e0, 0x07f0, 0x0ff0, 0x1e78, 0x3c3c, 0x781e, 0x0000, 0x0000, 0x0000,
+	  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// '^'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+	  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xffff, 0xffff, 0x0000, },	// '_'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x1e00, 0x0f00, 0x0700, 0x0380, 0x01c0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+	  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// '`'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0fe0, 0x3ff8, 0x3ff8, 0x303c, 0x003c,
+	  0x0ffc, 0x3ffc, 0x7ffc, 0x7c3c, 0x783c, 0x787c, 0x7ffc, 0x3ffc, 0x1f3c, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'a'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x3c00, 0x3c00, 0x3c00, 0x3c00, 0x3c00, 0x3c00, 0x3cf0, 0x3df8, 0x3ffc, 0x3e3c, 0x3c1e,
+	  0x3c1e, 0x3c1e, 0x3c1e, 0x3c1e, 0x3c1e, 0x3e3c, 0x3ffc, 0x3df8, 0x3cf0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'b'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x03f0, 0x0ff8, 0x1ff8, 0x1f08, 0x3e00,
+	  0x3c00, 0x3c00, 0x3c00, 0x3c00, 0x3e00, 0x1f08, 0x1ff8, 0x0ff8, 0x03f0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'c'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x003c, 0x003c, 0x003c, 0x003c, 0x003c, 0x003c, 0x0f3c, 0x1fbc, 0x3ffc, 0x7c7c, 0x783c,
+	  0x783c, 0x783c, 0x783c, 0x783c, 0x783c, 0x7c7c, 0x3ffc, 0x1fbc, 0x0f3c, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'd'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x07c0, 0x1ff0, 0x3ff8, 0x3c78, 0x783c,
+	  0x783c, 0x7ffc, 0x7ffc, 0x7ffc, 0x7800, 0x3c08, 0x3ff8, 0x1ff8, 0x07f0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'e'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x00fc, 0x01fc, 0x03fc, 0x03c0, 0x03c0, 0x03c0, 0x1ffc, 0x1ffc, 0x1ffc, 0x03c0, 0x03c0,
+	  0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'f'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0f3c, 0x1ffc, 0x3ffc, 0x3c7c, 0x783c,
+	  0x783c, 0x783c, 0x783c, 0x783c, 0x783c, 0x3c7c, 0x3ffc, 0x1ffc, 0x0fbc, 0x003c, 0x207c, 0x3ff8, 0x3ff0, 0x1fe0, 0x0000, 0x0000, },	// 'g'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x3c00, 0x3c00, 0x3c00, 0x3c00, 0x3c00, 0x3c00, 0x3de0, 0x3ff0, 0x3ff8, 0x3e78, 0x3c78,
+	  0x3c78, 0x3c78, 0x3c78, 0x3c78, 0x3c78, 0x3c78, 0x3c78, 0x3c78, 0x3c78, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'h'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x0000, 0x0000, 0x0000, 0x3fc0, 0x3fc0, 0x3fc0, 0x03c0, 0x03c0,
+	  0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x7ffe, 0x7ffe, 0x7ffe, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'i'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x01e0, 0x01e0, 0x01e0, 0x01e0, 0x0000, 0x0000, 0x0000, 0x1fe0, 0x1fe0, 0x1fe0, 0x01e0, 0x01e0,
+	  0x01e0, 0x01e0, 0x01e0, 0x01e0, 0x01e0, 0x01e0, 0x01e0, 0x01e0, 0x01e0, 0x01e0, 0x03e0, 0x3fc0, 0x3fc0, 0x3f00, 0x0000, 0x0000, },	// 'j'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x3c00, 0x3c00, 0x3c00, 0x3c00, 0x3c00, 0x3c00, 0x3c3c, 0x3c78, 0x3cf0, 0x3de0, 0x3fc0,
+	  0x3fc0, 0x3fc0, 0x3fe0, 0x3cf0, 0x3cf0, 0x3c78, 0x3c78, 0x3c3c, 0x3c1e, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'k'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x7f80, 0x7f80, 0x7f80, 0x0780, 0x0780, 0x0780, 0x0780, 0x0780, 0x0780, 0x0780, 0x0780,
+	  0x0780, 0x0780, 0x0780, 0x0780, 0x0780, 0x07c0, 0x03fc, 0x03fc, 0x01fc, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'l'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x7778, 0x7f78, 0x7ffc, 0x739c, 0x739c,
+	  0x739c, 0x739c, 0x739c, 0x739c, 0x739c, 0x739c, 0x739c, 0x739c, 0x739c, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'm'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x3de0, 0x3ff0, 0x3ff8, 0x3e78, 0x3c78,
+	  0x3c78, 0x3c78, 0x3c78, 0x3c78, 0x3c78, 0x3c78, 0x3c78, 0x3c78, 0x3c78, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'n'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x07c0, 0x1ff0, 0x3ff8, 0x3c78, 0x783c,
+	  0x783c, 0x783c, 0x783c, 0x783c, 0x783c, 0x3c78, 0x3ff8, 0x1ff0, 0x07c0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'o'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x3cf0, 0x3df8, 0x3ffc, 0x3e3c, 0x3c1e,
+	  0x3c1e, 0x3c1e, 0x3c1e, 0x3c1e, 0x3c1e, 0x3e3c, 0x3ffc, 0x3df8, 0x3cf0, 0x3c00, 0x3c00, 0x3c00, 0x3c00, 0x3c00, 0x0000, 0x0000, },	// 'p'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0f3c, 0x1fbc, 0x3ffc, 0x7c7c, 0x783c,
+	  0x783c, 0x783c, 0x783c, 0x783c, 0x783c, 0x7c7c, 0x3ffc, 0x1fbc, 0x0f3c, 0x003c, 0x003c, 0x003c, 0x003c, 0x003c, 0x0000, 0x0000, },	// 'q'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0f3c, 0x0f7e, 0x0ffe, 0x0fc2, 0x0f80,
+	  0x0f00, 0x0f00, 0x0f00, 0x0f00, 0x0f00, 0x0f00, 0x0f00, 0x0f00, 0x0f00, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'r'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x07e0, 0x1ff0, 0x3ff0, 0x3c10, 0x3c00,
+	  0x3f80, 0x1ff0, 0x0ff0, 0x00f8, 0x0078, 0x2078, 0x3ff8, 0x3ff0, 0x0fe0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 's'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0780, 0x0780, 0x0780, 0x0780, 0x7ffc, 0x7ffc, 0x7ffc, 0x0780, 0x0780,
+	  0x0780, 0x0780, 0x0780, 0x0780, 0x0780, 0x0780, 0x07fc, 0x03fc, 0x01fc, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 't'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x3c78, 0x3c78, 0x3c78, 0x3c78, 0x3c78,
+	  0x3c78, 0x3c78, 0x3c78, 0x3c78, 0x3c78, 0x3cf8, 0x3ff8, 0x1ff8, 0x0f78, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'u'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x781e, 0x781e, 0x3c3c, 0x3c3c, 0x3c3c,
+	  0x1c38, 0x1e78, 0x1e78, 0x0e70, 0x0ff0, 0x0ff0, 0x07e0, 0x07e0, 0x07e0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'v'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xe007, 0xe007, 0xf00f, 0x700e, 0x73ce,
+	  0x73ce, 0x73ce, 0x73ce, 0x3ffc, 0x3e7c, 0x3e7c, 0x3e7c, 0x3e7c, 0x1c38, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'w'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x7c3e, 0x3c3c, 0x1e78, 0x0ff0, 0x0ff0,
+	  0x07e0, 0x03c0, 0x07e0, 0x07e0, 0x0ff0, 0x1e78, 0x1e78, 0x3c3c, 0x7c3e, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'x'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x781e, 0x381c, 0x3c3c, 0x3c3c, 0x1e38,
+	  0x1e78, 0x0e78, 0x0ff0, 0x0ff0, 0x07e0, 0x07e0, 0x03e0, 0x03c0, 0x03c0, 0x0380, 0x0780, 0x3f80, 0x3f00, 0x3e00, 0x0000, 0x0000, },	// 'y'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x3ffc, 0x3ffc, 0x3ffc, 0x0078, 0x00f0,
+	  0x01f0, 0x03e0, 0x07c0, 0x0f80, 0x0f00, 0x1e00, 0x3ffc, 0x3ffc, 0x3ffc, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// 'z'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x00fc, 0x01fc, 0x03e0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x07c0,
+	  0x3f00, 0x3f00, 0x07c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03e0, 0x01fc, 0x00fc, 0x0000, 0x0000, 0x0000, },	// '{'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0380, 0x0380, 0x0380, 0x0380, 0x0380, 0x0380, 0x0380, 0x0380, 0x0380, 0x0380, 0x0380,
+	  0x0380, 0x0380, 0x0380, 0x0380, 0x0380, 0x0380, 0x0380, 0x0380, 0x0380, 0x0380, 0x0380, 0x0380, 0x0380, 0x0380, 0x0380, 0x0000, },	// '|'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x3f00, 0x3f80, 0x07c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03e0,
+	  0x00fc, 0x00fc, 0x03e0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x03c0, 0x07c0, 0x3f80, 0x3f00, 0x0000, 0x0000, 0x0000, },	// '}'
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x1e04,
+	  0x7f8c, 0x7ffc, 0x61fc, 0x00f0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, },	// '~'
+};
+
+  // Each glyph sits centered in a square slot, so the blank margin keeps
+  // neighbors from bleeding into each other in the smaller mipmaps
+static const int SLOT_SIZE	   = GlyphAtlas::GLYPH_HEIGHT;
+static const int SLOTS_PER_ROW = 16;
+static const int ATLAS_WIDTH   = SLOT_SIZE * SLOTS_PER_ROW;
+static const int ATLAS_HEIGHT  = SLOT_SIZE * 8;
+static const int GLYPH_MARGIN  = (SLOT_SIZE - GlyphAtlas::GLYPH_WIDTH) / 2;
+
+static_assert(NUM_GLYPHS <= SLOTS_PER_ROW * (ATLAS_HEIGHT / SLOT_SIZE), "GlyphAtlas is too small");
+
+GlyphAtlas::GlyphAtlas()
+ : m_texture(0)
+{
+}
+
+GlyphAtlas::~GlyphAtlas()
+{
+	if (m_texture != 0)
+		glDeleteTextures(1, &m_texture);
+}
+
+void GlyphAtlas::create()
+{
+	if (m_texture != 0)
+		return;
+
+	  // Expand the bitmaps into an alpha texture, top row first
+	vector<unsigned char> pixels(ATLAS_WIDTH * ATLAS_HEIGHT, 0);
+	for (int g = 0; g < NUM_GLYPHS; g++)
+	{
+		int left = (g % SLOTS_PER_ROW) * SLOT_SIZE + GLYPH_MARGIN;
+		int top = (g / SLOTS_PER_ROW) * SLOT_SIZE;
+		for (int row = 0; row < GLYPH_HEIGHT; row++)
+		{
+			unsigned char* p = &pixels[(top + row) * ATLAS_WIDTH + left];
+			for (int col = 0; col < GLYPH_WIDTH; col++)
+				if (FONT_GLYPHS[g][row] & (0x8000 >> col))
+					p[col] = 255;
+		}
+	}
+
+	glGenTextures(1, &m_texture);
+	glBindTexture(GL_TEXTURE_2D, m_texture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+	  // The HUD is drawn well below the font's native size, so box-filter a
+	  // full mipmap chain rather than letting the glyphs alias
+	int width = ATLAS_WIDTH;
+	int height = ATLAS_HEIGHT;
+	for (int level = 0; ; level++)
+	{
+		glTexImage2D(GL_TEXTURE_2D, level, GL_ALPHA, width, height, 0, GL_ALPHA, GL_UNSIGNED_BYTE, pixels.data());
+		if (width == 1  &&  height == 1)
+			break;
+
+		int halfWidth = max(width / 2, 1);
+		int halfHeight = max(height / 2, 1);
+		vector<unsigned char> half(halfWidth * halfHeight);
+		for (int y = 0; y < halfHeight; y++)
+			for (int x = 0; x < halfWidth; x++)
+			{
+				int x0 = min(2 * x, width - 1), x1 = min(2 * x + 1, width - 1);
+				int y0 = min(2 * y, height - 1), y1 = min(2 * y + 1, height - 1);
+				half[y * halfWidth + x] = static_cast<unsigned char>(
+					(pixels[y0 * width + x0] + pixels[y0 * width + x1] +
+					 pixels[y1 * width + x0] + pixels[y1 * width + x1] + 2) / 4);
+			}
+		pixels.swap(half);
+		width = halfWidth;
+		height = halfHeight;
+	}
+}
+
+void GlyphAtlas::texCoords(char c, GLfloat& s0, GLfloat& t0, GLfloat& s1, GLfloat& t1) const
+{
+	if (c < FIRST_CHAR  ||  c > LAST_CHAR)
+		c = '?';
+	int g = c - FIRST_CHAR;
+	int left = (g % SLOTS_PER_ROW) * SLOT_SIZE + GLYPH_MARGIN;
+	int top = (g / SLOTS_PER_ROW) * SLOT_SIZE;
+	s0 = static_cast<GLfloat>(left) / ATLAS_WIDTH;
+	s1 = static_cast<GLfloat>(left + GLYPH_WIDTH) / ATLAS_WIDTH;
+	t0 = static_cast<GLfloat>(top) / ATLAS_HEIGHT;
+	t1 = static_cast<GLfloat>(top + GLYPH_HEIGHT) / ATLAS_HEIGHT;
+}
+
+void TextRun::setText(const string& str, const GlyphAtlas& atlas)
+{
+	if (str == m_text)
+		return;
+	m_text = str;
+	m_vertices.clear();
+
+	  // In units of one character cell's height, with the origin at the
+	  // middle of the baseline
+	const GLfloat advance = static_cast<GLfloat>(GlyphAtlas::GLYPH_WIDTH) / GlyphAtlas::GLYPH_HEIGHT;
+	const GLfloat top = static_cast<GLfloat>(GlyphAtlas::BASELINE) / GlyphAtlas::GLYPH_HEIGHT;
+	const GLfloat bottom = top - 1;
+	GLfloat x = -advance * str.size() / 2;
+	for (char c : str)
+	{
+		if (c != ' ')
+		{
+			GLfloat s0, t0, s1, t1;
+			atlas.texCoords(c, s0, t0, s1, t1);
+			GLfloat quad[] = {
+				s0, t1, x,			 bottom,
+				s1, t1, x + advance, bottom,
+				s1, t0, x + advance, top,
+				s0, t0, x,			 top,
+			};
+			m_vertices.insert(m_vertices.end(), quad, quad + sizeof(quad)/sizeof(quad[0]));
+		}
+		x += advance;
+	}
+}
+
+void TextRun::drawCentered(const GlyphAtlas& atlas, double y, double z, double height) const
+{
+	if (m_vertices.empty())
+		return;
+
+	glPushMatrix();
+	glLoadIdentity();
+	glTranslatef(0, static_cast<GLfloat>(y), static_cast<GLfloat>(z));
+	glScalef(static_cast<GLfloat>(height), static_cast<GLfloat>(height), 1);
+	glPushAttrib(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_ENABLE_BIT | GL_TEXTURE_BIT);
+	glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+	glEnable(GL_TEXTURE_2D);
+	glDisable(GL_DEPTH_TEST);
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	glBindTexture(GL_TEXTURE_2D, atlas.texture());
+	glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+
+	const GLsizei stride = 4 * sizeof(GLfloat);
+	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glTexCoordPointer(2, GL_FLOAT, stride, &m_vertices[0]);
+	glVertexPointer(2, GL_FLOAT, stride, &m_vertices[2]);
+	glDrawArrays(GL_QUADS, 0, static_cast<GLsizei>(m_vertices.size() / 4));
+
+	glPopClientAttrib();
+	glPopAttrib();
+	glPopMatrix();
+}
@@ -0,0 +1,64 @@
+#ifndef GLYPHATLAS_H_
+#define GLYPHATLAS_H_
+
+#include "freeglut.h"
+#include <string>
+#include <vector>
+
+  // A texture holding every printable ASCII character, built once at
+  // startup from a bitmap font compiled into the program.  Text drawn from
+  // it costs one textured quad per character instead of the dozens of line
+  // segments glutStrokeCharacter emits, and it doesn't need GLUT at all.
+
+class GlyphAtlas
+{
+public:
+	  // Each character is a GLYPH_WIDTH x GLYPH_HEIGHT bitmap with its
+	  // baseline BASELINE rows down from the top
+	static const int GLYPH_WIDTH  = 16;
+	static const int GLYPH_HEIGHT = 32;
+	static const int BASELINE	  = 25;
+	static const char FIRST_CHAR  = ' ';
+	static const char LAST_CHAR	  = '~';
+
+	GlyphAtlas();
+	~GlyphAtlas();
+
+	  // Builds the texture; a GL context must be current
+	void create();
+
+	GLuint texture() const
+	{
+		return m_texture;
+	}
+
+	  // Where character c is in the texture; characters the font doesn't
+	  // have come back as '?'
+	void texCoords(char c, GLfloat& s0, GLfloat& t0, GLfloat& s1, GLfloat& t1) const;
+
+private:
+	GLuint m_texture;
+
+	GlyphAtlas(const GlyphAtlas&) = delete;
+	GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+};
+
+  // A string laid out as a list of textured quads, one per character.  The
+  // layout is only redone when the string changes, so text that stays the
+  // same from frame to frame is just a single draw call.
+
+class TextRun
+{
+public:
+	void setText(const std::string& str, const GlyphAtlas& atlas);
+
+	  // Draws the text centered horizontally at (0, y, z) with its baseline
+	  // at y, scaled so a character cell is height units tall
+	void drawCentered(const GlyphAtlas& atlas, double y, double z, double height) const;
+
+private:
+	std::string			 m_text;
+	std::vector<GLfloat> m_vertices;	// s, t, x, y for each corner of each quad
+};
+
+#endif // GLYPHATLAS_H_
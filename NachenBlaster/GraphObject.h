@@ -2,26 +2,39 @@
 #define GRAPHOBJ_H_
 
 #include "GameConstants.h"
-#include <set>
-
-const int ANIMATION_POSITIONS_PER_TICK = 1;
-
 
 class GraphObject
 {
 protected:
 	GraphObject(int imageID, double startX, double startY, int dir = 0, double size = 1.0, int depth = 0)
 	 : m_imageID(imageID), m_animationNumber(0), m_x(startX), m_y(startY),
-	   m_destX(startX), m_destY(startY), m_direction(dir),
-	   m_size(size <= 0 ? 1 : size), m_depth(depth)
+	   m_destX(startX), m_destY(startY), m_direction(dir), m_drawnDirection(dir), m_drawn(false),
+	   m_size(size <= 0 ? 1 : size), m_depth(depth), m_tracked(tracksNewObjects()),
+	   m_prevTracked(nullptr), m_nextTracked(nullptr)
 	{
-		getGraphObjects(m_depth).insert(this);
+		if (m_tracked)
+			getGraphObjects(m_depth).append(this);
 	}
 
 public:
+	static const int NUM_DEPTHS = 4;
+	  // Objects at the back depth are the background (see
+	  // GameWorld::scrollBackground)
+	static const int BACKGROUND_DEPTH = NUM_DEPTHS - 1;
+
 	virtual ~GraphObject()
 	{
-		getGraphObjects(m_depth).erase(this);
+		if (m_tracked)
+			getGraphObjects(m_depth).remove(this);
+	}
+
+	  // Objects are only drawn if they're tracked.  Threads that run worlds
+	  // nobody looks at (see BatchEnv) can turn tracking off for everything
+	  // they create, and skip the bookkeeping.
+	static bool& tracksNewObjects()
+	{
+		thread_local bool tracking = true;
+		return tracking;
 	}
 
     double getX() const
@@ -43,6 +56,11 @@ public:
         m_animationNumber++;
     }
 
+    int getImageID() const
+    {
+        return m_imageID;
+    }
+
     int getDirection() const
     {
         return m_direction;
@@ -72,53 +90,84 @@ public:
 		return RADIUS_PER_UNIT * m_size;
 	}
 
+      // Each object is plotted with where it was when objects were last
+      // drawn (fromX, fromY, fromAngle) as well as where it is now, so the
+      // renderer can blend between the two.  An object that hasn't been
+      // drawn before comes from where it is now.
     template<typename Func>
     static void drawAllObjects(Func plotFunc)
     {
         for (int depth = NUM_DEPTHS - 1; depth >= 0; depth--)
         {
-            for (GraphObject* go : getGraphObjects(depth))
+            for (GraphObject* go = getGraphObjects(depth).first; go != nullptr; go = go->m_nextTracked)
             {
+                if (!go->m_drawn)
+                    go->animate();
+                plotFunc(go->m_imageID, go->m_animationNumber, go->m_x, go->m_y, go->m_drawnDirection,
+                         go->m_destX, go->m_destY, go->m_direction, go->m_size, depth);
                 go->animate();
-                plotFunc(go->m_imageID, go->m_animationNumber, go->m_x, go->m_y, go->m_direction, go->m_size);
             }
         }
     }
 
 private:
-    static const int NUM_DEPTHS = 4;
     int             m_imageID;
     unsigned int    m_animationNumber;
-    double          m_x;
+    double          m_x;                // where the object was last drawn
     double          m_y;
-    double          m_destX;
+    double          m_destX;            // where it is now
     double          m_destY;
     int				m_direction;
+    int             m_drawnDirection;
+    bool            m_drawn;
     double          m_size;
     int             m_depth;
+    bool            m_tracked;
+    GraphObject*    m_prevTracked;
+    GraphObject*    m_nextTracked;
 
     void animate()
     {
         m_x = m_destX;
         m_y = m_destY;
-        // moveALittle(m_x, m_destX);
-        // moveALittle(m_y, m_destY);
+        m_drawnDirection = m_direction;
+        m_drawn = true;
     }
- 
-    void moveALittle(double& from, double& to)
+
+      // The tracked objects at each depth, linked through the objects
+      // themselves so tracking one never allocates.  Objects at the same
+      // depth are drawn in the order they were created.
+    struct TrackedList
     {
-        static const double DISTANCE = 1.0/ANIMATION_POSITIONS_PER_TICK;
-        if (to - from >= DISTANCE)
-            from += DISTANCE;
-        else if (from - to >= DISTANCE)
-            from -= DISTANCE;
-        else
-            from = to;
-    }
+        GraphObject* first;
+        GraphObject* last;
+
+        void append(GraphObject* go)
+        {
+            go->m_prevTracked = last;
+            if (last != nullptr)
+                last->m_nextTracked = go;
+            else
+                first = go;
+            last = go;
+        }
+
+        void remove(GraphObject* go)
+        {
+            if (go->m_prevTracked != nullptr)
+                go->m_prevTracked->m_nextTracked = go->m_nextTracked;
+            else
+                first = go->m_nextTracked;
+            if (go->m_nextTracked != nullptr)
+                go->m_nextTracked->m_prevTracked = go->m_prevTracked;
+            else
+                last = go->m_prevTracked;
+        }
+    };
 
-    static std::set<GraphObject*>& getGraphObjects(int depth)
+    static TrackedList& getGraphObjects(int depth)
     {
-        static std::set<GraphObject*> m_graphObjects[NUM_DEPTHS];
+        static TrackedList m_graphObjects[NUM_DEPTHS];
         if (depth < NUM_DEPTHS)
             return m_graphObjects[depth];
         else
@@ -0,0 +1,104 @@
+#ifndef INPUTQUEUE_H_
+#define INPUTQUEUE_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+using InputClock = std::chrono::steady_clock;
+
+  // A key press along with the time the window system delivered it
+
+struct InputEvent
+{
+	int					   key;
+	InputClock::time_point arrival;
+};
+
+  // Lock-free single-producer, single-consumer ring buffer.  The producer
+  // only writes m_tail and the consumer only writes m_head, so neither side
+  // ever waits on the other.  Capacity must be a power of two.
+
+template<typename T, std::size_t Capacity>
+class SpscRing
+{
+	static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+				  "SpscRing capacity must be a power of two");
+public:
+	SpscRing()
+	 : m_head(0), m_tail(0)
+	{
+	}
+
+	  // Producer side.  Returns false (and drops the item) only if the
+	  // consumer has fallen a full Capacity items behind.
+	bool push(const T& item)
+	{
+		std::size_t tail = m_tail.load(std::memory_order_relaxed);
+		if (tail - m_head.load(std::memory_order_acquire) == Capacity)
+			return false;
+		m_items[tail & (Capacity - 1)] = item;
+		m_tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	  // Consumer side
+	bool pop(T& item)
+	{
+		std::size_t head = m_head.load(std::memory_order_relaxed);
+		if (head == m_tail.load(std::memory_order_acquire))
+			return false;
+		item = m_items[head & (Capacity - 1)];
+		m_head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	  // Consumer side
+	void clear()
+	{
+		m_head.store(m_tail.load(std::memory_order_acquire), std::memory_order_release);
+	}
+
+private:
+	static const std::size_t CACHE_LINE = 64;
+
+	  // Padding rather than alignas keeps the two indexes on separate cache
+	  // lines without making the ring (or anything that holds one) over-aligned,
+	  // which operator new doesn't honor before C++17
+	char					 m_padBefore[CACHE_LINE];
+	std::atomic<std::size_t> m_head;
+	char					 m_padHead[CACHE_LINE - sizeof(std::atomic<std::size_t>)];
+	std::atomic<std::size_t> m_tail;
+	char					 m_padTail[CACHE_LINE - sizeof(std::atomic<std::size_t>)];
+	T						 m_items[Capacity];
+};
+
+  // Running statistics on how long input events wait, in microseconds
+
+struct InputLatency
+{
+	InputLatency()
+	 : count(0), totalMicros(0), maxMicros(0)
+	{
+	}
+
+	void record(InputClock::time_point from, InputClock::time_point to)
+	{
+		long long us = std::chrono::duration_cast<std::chrono::microseconds>(to - from).count();
+		count++;
+		totalMicros += us;
+		if (us > maxMicros)
+			maxMicros = us;
+	}
+
+	double averageMicros() const
+	{
+		return count == 0 ? 0 : static_cast<double>(totalMicros) / count;
+	}
+
+	long long count;
+	long long totalMicros;
+	long long maxMicros;
+};
+
+#endif // INPUTQUEUE_H_
@@ -0,0 +1,44 @@
+#include "KeyRecording.h"
+using namespace std;
+
+static const char* const HEADER = "NachenBlaster key recording 1";
+
+bool KeyRecording::startRecording(const string& filename, unsigned int seed)
+{
+	m_out.open(filename.c_str());
+	if (!m_out)
+		return false;
+	m_out << HEADER << '\n' << "seed " << seed << '\n';
+	return true;
+}
+
+bool KeyRecording::startPlayback(const string& filename, unsigned int& seed)
+{
+	ifstream in(filename.c_str());
+	string header;
+	string seedLabel;
+	if (!getline(in, header)  ||  header != HEADER  ||  !(in >> seedLabel >> seed)  ||  seedLabel != "seed")
+		return false;
+
+	unsigned long tick;
+	int key;
+	while (in >> tick >> key)
+		m_keys.push_back(make_pair(tick, key));
+	if (!in.eof())
+		return false;
+
+	m_playing = true;
+	m_next = 0;
+	return true;
+}
+
+bool KeyRecording::saveHistory(const string& filename) const
+{
+	ofstream out(filename.c_str());
+	if (!out)
+		return false;
+	out << HEADER << '\n' << "seed " << m_seed << '\n';
+	for (const pair<unsigned long, int>& k : m_history)
+		out << k.first << ' ' << k.second << '\n';
+	return static_cast<bool>(out);
+}
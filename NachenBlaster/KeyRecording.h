@@ -0,0 +1,80 @@
+#ifndef KEYRECORDING_H_
+#define KEYRECORDING_H_
+
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+  // The random seed a game was played with, and every key it handled along
+  // with the tick that handled it.  Since the simulation is deterministic
+  // given those, playing the keys back on the same ticks with the same seed
+  // replays the game exactly.
+  //
+  // The file is text: a header line, "seed N", then one "TICK KEY" line
+  // per key.
+
+class KeyRecording
+{
+public:
+	KeyRecording()
+	 : m_playing(false), m_next(0), m_keepingHistory(false), m_seed(0)
+	{
+	}
+
+	bool startRecording(const std::string& filename, unsigned int seed);
+	bool startPlayback(const std::string& filename, unsigned int& seed);
+
+	bool isRecording() const
+	{
+		return m_out.is_open();
+	}
+
+	bool isPlaying() const
+	{
+		return m_playing;
+	}
+
+	  // Keeps every key recorded from now on in memory, so that a recording
+	  // of the game so far can be saved at any point
+	void keepHistory(unsigned int seed)
+	{
+		m_keepingHistory = true;
+		m_seed = seed;
+	}
+
+	bool isKeepingHistory() const
+	{
+		return m_keepingHistory;
+	}
+
+	bool saveHistory(const std::string& filename) const;
+
+	void record(unsigned long tick, int key)
+	{
+		if (m_out.is_open())
+			m_out << tick << ' ' << key << '\n';
+		if (m_keepingHistory)
+			m_history.push_back(std::make_pair(tick, key));
+	}
+
+	  // The next recorded key for this tick, if any are left
+	bool nextKey(unsigned long tick, int& key)
+	{
+		if (m_next == m_keys.size()  ||  m_keys[m_next].first != tick)
+			return false;
+		key = m_keys[m_next++].second;
+		return true;
+	}
+
+private:
+	std::ofstream m_out;
+	bool		  m_playing;
+	std::vector<std::pair<unsigned long, int>> m_keys;
+	std::size_t	  m_next;
+	bool		  m_keepingHistory;
+	unsigned int  m_seed;
+	std::vector<std::pair<unsigned long, int>> m_history;
+};
+
+#endif // KEYRECORDING_H_
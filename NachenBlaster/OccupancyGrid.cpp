@@ -0,0 +1,112 @@
+#include "OccupancyGrid.h"
+#include "StudentWorld.h"
+#include "Actor.h"
+#include "GameConstants.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+using namespace std;
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OCCUPANCY_GRID_SSE2
+#endif
+
+// How far a point is from the nearest edge of a cell along one axis, or 0 if it's within the cell
+static inline float gapToCell(const float& center, const float& halfCell, const float& p)
+{
+    return max(abs(center - p) - halfCell, 0.0f);
+}
+
+// Marks every cell in one channel that a circle overlaps. A cell is in if dx * dx + dy * dy is
+// short of radius * radius, computed exactly that way for every cell so that rounding can't make
+// the answer depend on which path (or how many lanes) tested it. The range of cells to test is
+// one cell wider on every side than the circle's bounds, since dividing by the cell size rounds
+// too and could otherwise skip a cell the test would let in
+static void rasterizeCircle(float* channel, const int& width, const int& height, const float& cellW,
+                            const float& cellH, const float& x, const float& y, const float& radius)
+{
+    int col0 = max(0, static_cast<int>(floor((x - radius) / cellW)) - 1);
+    int col1 = min(width - 1, static_cast<int>(floor((x + radius) / cellW)) + 1);
+    int row0 = max(0, static_cast<int>(floor((y - radius) / cellH)) - 1);
+    int row1 = min(height - 1, static_cast<int>(floor((y + radius) / cellH)) + 1);
+    float halfW = cellW / 2;
+    float halfH = cellH / 2;
+    float radiusSquared = radius * radius;
+
+    for (int row = row0; row <= row1; row++)
+    {
+        float dy = gapToCell((row + 0.5f) * cellH, halfH, y);
+        float dySquared = dy * dy;
+        if (dySquared >= radiusSquared)  // No cell in the row can make it under
+            continue;
+        float* cells = channel + row * width;
+        int col = col0;
+
+#ifdef OCCUPANCY_GRID_SSE2
+        // Four cells at a time: 1 wherever the squared distance is short of the squared radius, and
+        // max() with what's already there so overlapping Actors don't add up
+        const __m128 steps = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+        const __m128 signBits = _mm_set1_ps(-0.0f);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1);
+        const __m128 px = _mm_set1_ps(x);
+        const __m128 vHalfW = _mm_set1_ps(halfW);
+        const __m128 vCellW = _mm_set1_ps(cellW);
+        const __m128 vDySquared = _mm_set1_ps(dySquared);
+        const __m128 vRadiusSquared = _mm_set1_ps(radiusSquared);
+        for ( ; col + 3 <= col1; col += 4)
+        {
+            __m128 centers = _mm_mul_ps(_mm_add_ps(_mm_set1_ps(static_cast<float>(col)), steps), vCellW);
+            __m128 gap = _mm_max_ps(_mm_sub_ps(_mm_andnot_ps(signBits, _mm_sub_ps(centers, px)), vHalfW), zero);
+            __m128 inside = _mm_cmplt_ps(_mm_add_ps(_mm_mul_ps(gap, gap), vDySquared), vRadiusSquared);
+            __m128 old = _mm_loadu_ps(cells + col);
+            _mm_storeu_ps(cells + col, _mm_max_ps(old, _mm_and_ps(inside, one)));
+        }
+#endif
+
+        for ( ; col <= col1; col++)
+        {
+            float dx = gapToCell((col + 0.5f) * cellW, halfW, x);
+            if (dx * dx + dySquared < radiusSquared)
+                cells[col] = 1;
+        }
+    }
+}
+
+// Which channel each layer goes in
+static int layerChannel(const int& layer)
+{
+    switch (layer)
+    {
+        case LAYER_PLAYER:       return GRID_CHANNEL_PLAYER;
+        case LAYER_PLAYER_SHOTS: return GRID_CHANNEL_PLAYER_SHOTS;
+        case LAYER_ALIEN_SHOTS:  return GRID_CHANNEL_ALIEN_SHOTS;
+        case LAYER_ALIENS:       return GRID_CHANNEL_ALIENS;
+        case LAYER_GOODIES:      return GRID_CHANNEL_GOODIES;
+        default:                 return -1;
+    }
+}
+
+void rasterizeOccupancy(const StudentWorld& world, const int& width, const int& height, float* out)
+{
+    size_t cellsPerChannel = static_cast<size_t>(width) * height;
+    memset(out, 0, GRID_CHANNELS * cellsPerChannel * sizeof(float));
+    float cellW = static_cast<float>(VIEW_WIDTH) / width;
+    float cellH = static_cast<float>(VIEW_HEIGHT) / height;
+
+    auto plot = [&](const Actor* a)
+    {
+        int channel = layerChannel(a->getLayer());
+        if (!a->isAlive() || channel < 0)
+            return;
+        rasterizeCircle(out + channel * cellsPerChannel, width, height, cellW, cellH,
+                        static_cast<float>(a->getX()), static_cast<float>(a->getY()),
+                        static_cast<float>(a->getRadius()));
+    };
+
+    const Blaster* blaster = world.getBlaster();
+    if (blaster != nullptr)
+        plot(blaster);
+    world.forEachCollidable(plot);
+}
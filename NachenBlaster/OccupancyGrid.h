@@ -0,0 +1,30 @@
+#ifndef OCCUPANCYGRID_H_
+#define OCCUPANCYGRID_H_
+
+class StudentWorld;
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Manifest Constants
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+const int GRID_CHANNEL_PLAYER       = 0; // One channel per collision layer, in the order of the
+const int GRID_CHANNEL_PLAYER_SHOTS = 1; // LAYER_ bits
+const int GRID_CHANNEL_ALIEN_SHOTS  = 2;
+const int GRID_CHANNEL_ALIENS       = 3;
+const int GRID_CHANNEL_GOODIES      = 4;
+const int GRID_CHANNELS             = 5;
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Occupancy Grid
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+// A low-resolution picture of where everything is, for bots and analysis tools. The playfield is
+// divided into width x height cells, and a cell is 1 in a channel if any living Actor on that
+// channel's layer overlaps it (as a circle of GraphObject::getRadius()) and 0 otherwise.
+//
+// out must hold GRID_CHANNELS * width * height floats. It is filled one channel after another,
+// each channel row by row from the bottom of the screen, and nothing else is allocated, so this
+// is cheap enough to run for every world every tick.
+void rasterizeOccupancy(const StudentWorld& world, const int& width, const int& height, float* out);
+
+#endif // OCCUPANCYGRID_H_
@@ -0,0 +1,150 @@
+#ifndef OFFSCREENCONTEXT_H_
+#define OFFSCREENCONTEXT_H_
+
+#include <string>
+#include <vector>
+
+  // An OpenGL context that draws into an offscreen pbuffer instead of a
+  // window, so the game can be rendered with no display at all (e.g., on
+  // Mesa's llvmpipe software rasterizer on a CI machine).  The context is
+  // a compatibility profile, so the same immediate-mode drawing code that
+  // the window uses works unchanged.
+
+#if defined(__linux__)
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include "freeglut.h"
+
+#ifndef GL_BGRA
+#define GL_BGRA GL_BGRA_EXT
+#endif
+
+class OffscreenContext
+{
+  public:
+	OffscreenContext()
+	 : m_display(EGL_NO_DISPLAY), m_surface(EGL_NO_SURFACE), m_context(EGL_NO_CONTEXT),
+	   m_width(0), m_height(0)
+	{
+	}
+
+	~OffscreenContext()
+	{
+		if (m_display == EGL_NO_DISPLAY)
+			return;
+		eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+		if (m_context != EGL_NO_CONTEXT)
+			eglDestroyContext(m_display, m_context);
+		if (m_surface != EGL_NO_SURFACE)
+			eglDestroySurface(m_display, m_surface);
+		eglTerminate(m_display);
+	}
+
+	  // Creates the context and makes it current on the calling thread
+	bool create(int width, int height, std::string& error)
+	{
+		m_display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+		EGLint major, minor;
+		if (!eglInitialize(m_display, &major, &minor))
+		{
+			  // No window system; ask Mesa for a display that needs none
+			PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+				reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+			m_display = (getPlatformDisplay == nullptr ? EGL_NO_DISPLAY :
+						 getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr));
+			if (m_display == EGL_NO_DISPLAY || !eglInitialize(m_display, &major, &minor))
+			{
+				m_display = EGL_NO_DISPLAY;
+				error = "Cannot open an EGL display";
+				return false;
+			}
+		}
+
+		const EGLint configAttribs[] = {
+			EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+			EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_ALPHA_SIZE, 8,
+			EGL_DEPTH_SIZE, 16,
+			EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+			EGL_NONE
+		};
+		EGLConfig config;
+		EGLint numConfigs;
+		if (!eglChooseConfig(m_display, configAttribs, &config, 1, &numConfigs) || numConfigs == 0)
+		{
+			error = "No EGL config supports desktop OpenGL in a pbuffer";
+			return false;
+		}
+
+		const EGLint surfaceAttribs[] = { EGL_WIDTH, width, EGL_HEIGHT, height, EGL_NONE };
+		m_surface = eglCreatePbufferSurface(m_display, config, surfaceAttribs);
+		if (m_surface == EGL_NO_SURFACE)
+		{
+			error = "Cannot create an EGL pbuffer";
+			return false;
+		}
+
+		eglBindAPI(EGL_OPENGL_API);
+		m_context = eglCreateContext(m_display, config, EGL_NO_CONTEXT, nullptr);
+		if (m_context == EGL_NO_CONTEXT  ||  !eglMakeCurrent(m_display, m_surface, m_surface, m_context))
+		{
+			error = "Cannot create an OpenGL context";
+			return false;
+		}
+
+		m_width = width;
+		m_height = height;
+		return true;
+	}
+
+	  // Reads back the finished frame as BGRA, bottom row first
+	void readPixels(std::vector<unsigned char>& pixels) const
+	{
+		glFinish();
+		pixels.resize(static_cast<size_t>(m_width) * m_height * 4);
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glReadPixels(0, 0, m_width, m_height, GL_BGRA, GL_UNSIGNED_BYTE, pixels.data());
+	}
+
+	  // For OpenGL functions that aren't linked directly
+	static void* getProcAddress(const char* name)
+	{
+		return reinterpret_cast<void*>(eglGetProcAddress(name));
+	}
+
+  private:
+	EGLDisplay m_display;
+	EGLSurface m_surface;
+	EGLContext m_context;
+	int		   m_width;
+	int		   m_height;
+
+	OffscreenContext(const OffscreenContext&);
+	OffscreenContext& operator=(const OffscreenContext&);
+};
+
+#else  // no offscreen rendering on this platform
+
+class OffscreenContext
+{
+  public:
+	bool create(int, int, std::string& error)
+	{
+		error = "Headless rendering is only supported on Linux (EGL)";
+		return false;
+	}
+
+	void readPixels(std::vector<unsigned char>& pixels) const
+	{
+		pixels.clear();
+	}
+
+	static void* getProcAddress(const char*)
+	{
+		return nullptr;
+	}
+};
+
+#endif
+
+#endif // OFFSCREENCONTEXT_H_
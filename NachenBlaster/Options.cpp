@@ -0,0 +1,259 @@
+#include "Options.h"
+#include "GameWorld.h"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+using namespace std;
+
+static const int DEFAULT_WINDOW_WIDTH  = 768;
+static const int DEFAULT_WINDOW_HEIGHT = 768;
+
+  // The simulation used to advance one tick every makemove/animate cycle of
+  // 3 frames at 5ms each; keep that pace by default
+static const int	DEFAULT_MS_PER_FRAME	  = 5;
+static const double DEFAULT_TICKS_PER_SECOND = 1000.0 / (3 * DEFAULT_MS_PER_FRAME);
+
+static const int DEFAULT_HEADLESS_TICKS = 1000;
+static const int DEFAULT_ALLOC_CHECK_WARMUP = 300;
+
+Options::Options()
+ : windowWidth(DEFAULT_WINDOW_WIDTH), windowHeight(DEFAULT_WINDOW_HEIGHT),
+   msPerFrame(DEFAULT_MS_PER_FRAME), ticksPerSecond(DEFAULT_TICKS_PER_SECOND),
+   ticksPerFrame(1), unthrottled(false), interpolate(false), cachedBackground(false), internalHeight(0), quality(-1), qualityGiven(false), seeded(false), seed(0), autopilot(false),
+   headless(false), headlessTicks(DEFAULT_HEADLESS_TICKS), dumpEvery(1),
+   softwareRenderer(false), threads(0), batchWorlds(0), gridWidth(0), gridHeight(0),
+   watchdog(false), watchdogMs(-1), allocCheck(false),
+   allocCheckWarmup(DEFAULT_ALLOC_CHECK_WARMUP), actorStats(false), help(false)
+{
+}
+
+void printUsage(ostream& out, const char* program)
+{
+	out << "Usage: " << program << " [options]\n"
+		   "  --window=WxH         window (or headless framebuffer) size, default "
+		<< DEFAULT_WINDOW_WIDTH << "x" << DEFAULT_WINDOW_HEIGHT << "\n"
+		   "  --fps=N              how often the window is redrawn\n"
+		   "  --tick-rate=N        simulation ticks per second\n"
+		   "  --turbo=K            run K ticks for every rendered frame\n"
+		   "  --unthrottled        run ticks as fast as possible\n"
+		   "  --interpolate        smooth motion between ticks when redrawing faster\n"
+		   "                       than the tick rate, at the cost of a tick of lag\n"
+		   "  --background=cached|sprites\n"
+		   "                       draw the star field from one scrolling texture,\n"
+		   "                       or star by star (the default)\n"
+		   "  --internal-res=H     draw sprites H pixels high (and as wide as the window's\n"
+		   "                       shape needs), then scale them up to the window by a\n"
+		   "                       whole number, e.g. 256 for 3x in the default window\n"
+		   "  --quality=auto|N     cosmetic detail from " << QUALITY_MIN << " to " << QUALITY_MAX << ", default auto: lowered\n"
+		   "                       while frames take longer than the frame interval\n"
+		   "                       (headless runs default to " << QUALITY_MAX << ", so they repeat exactly)\n"
+		   "  --assets=DIR         where the sprites and sounds are\n"
+		   "  --seed=N             seed for the random number generator\n"
+		   "  --autopilot          let the program play by itself\n"
+		   "  --record=FILE        save the seed and every key the game handles\n"
+		   "  --replay=FILE        play back a game saved with --record\n"
+		   "  --headless[=TICKS]   play without a window, default " << DEFAULT_HEADLESS_TICKS << " ticks\n"
+		   "  --dump=PREFIX        save headless frames as PREFIX<tick>.tga\n"
+		   "  --dump-every=N       save only every Nth frame\n"
+		   "  --renderer=gl|software\n"
+		   "                       how headless frames are drawn\n"
+		   "  --threads=N          software renderer (or batch) threads, default one\n"
+		   "                       per core\n"
+		   "  --batch=N            step N worlds at once with random actions, for as\n"
+		   "                       many steps as --headless, and report the rate\n"
+		   "  --grid=WxH           with --batch, also rasterize a WxH occupancy grid of\n"
+		   "                       every world on every step\n"
+		   "  --event-log=FILE     record gameplay events\n"
+		   "  --trace=FILE         dump the world state after every tick\n"
+		   "  --profile=FILE       save per-tick and per-frame timings as CSV, and\n"
+		   "                       report the latency of keys the player hit\n"
+		   "  --watchdog[=MS]      report ticks and frames that take longer than MS,\n"
+		   "                       default the tick interval and frame interval\n"
+		   "  --watchdog-keys=PREFIX\n"
+		   "                       also save a recording that replays up to each\n"
+		   "                       slow tick, as PREFIX<tick>.keys\n"
+		   "  --alloc-check[=TICKS]\n"
+		   "                       report ticks that allocate memory after the first\n"
+		   "                       TICKS, default " << DEFAULT_ALLOC_CHECK_WARMUP << "; headless runs fail if any do\n"
+		   "  --actor-stats        report live and peak counts, allocations and bytes\n"
+		   "                       per Actor type at the end of each level\n"
+		   "  --help               show this message\n";
+}
+
+  // If arg is name=value, sets value and returns true
+static bool hasValue(const string& arg, const char* name, string& value)
+{
+	string prefix = string(name) + "=";
+	if (arg.compare(0, prefix.size(), prefix) != 0)
+		return false;
+	value = arg.substr(prefix.size());
+	return true;
+}
+
+  // Leaves result alone unless s is a whole number from minimum to INT_MAX
+static bool toInt(const string& s, int minimum, int& result)
+{
+	char* end;
+	errno = 0;
+	long n = strtol(s.c_str(), &end, 10);
+	if (s.empty()  ||  *end != '\0'  ||  errno == ERANGE  ||  n < minimum  ||  n > INT_MAX)
+		return false;
+	result = static_cast<int>(n);
+	return true;
+}
+
+  // Leaves result alone unless s is a whole number from 0 to UINT_MAX
+static bool toUnsigned(const string& s, unsigned int& result)
+{
+	char* end;
+	errno = 0;
+	unsigned long n = strtoul(s.c_str(), &end, 10);
+	if (s.empty()  ||  s[0] == '-'  ||  *end != '\0'  ||  errno == ERANGE  ||  n > UINT_MAX)
+		return false;
+	result = static_cast<unsigned int>(n);
+	return true;
+}
+
+bool parseOptions(int argc, char* argv[], Options& options, string& error)
+{
+	for (int k = 1; k < argc; k++)
+	{
+		string arg = argv[k];
+		if (arg.compare(0, 2, "--") != 0)
+			continue;
+
+		string value;
+		bool ok = true;
+		if (arg == "--help")
+			options.help = true;
+		else if (hasValue(arg, "--window", value))
+		{
+			size_t x = value.find('x');
+			ok = x != string::npos  &&
+				 toInt(value.substr(0, x), 1, options.windowWidth)  &&
+				 toInt(value.substr(x + 1), 1, options.windowHeight);
+		}
+		else if (hasValue(arg, "--fps", value))
+		{
+			int fps = 0;
+			ok = toInt(value, 1, fps);
+			if (ok)
+				options.msPerFrame = max(1, 1000 / fps);
+		}
+		else if (hasValue(arg, "--tick-rate", value))
+		{
+			int rate = 0;
+			ok = toInt(value, 1, rate);
+			options.ticksPerSecond = rate;
+		}
+		else if (hasValue(arg, "--turbo", value))
+			ok = toInt(value, 1, options.ticksPerFrame);
+		else if (arg == "--unthrottled")
+			options.unthrottled = true;
+		else if (arg == "--interpolate")
+			options.interpolate = true;
+		else if (hasValue(arg, "--internal-res", value))
+			ok = toInt(value, 1, options.internalHeight);
+		else if (hasValue(arg, "--background", value))
+		{
+			ok = (value == "cached"  ||  value == "sprites");
+			options.cachedBackground = (value == "cached");
+		}
+		else if (hasValue(arg, "--quality", value))
+		{
+			options.qualityGiven = true;
+			if (value == "auto")
+				options.quality = -1;
+			else
+				ok = toInt(value, QUALITY_MIN, options.quality)  &&  options.quality <= QUALITY_MAX;
+		}
+		else if (hasValue(arg, "--assets", value))
+			options.assetDirectory = value;
+		else if (hasValue(arg, "--seed", value))
+		{
+			ok = toUnsigned(value, options.seed);
+			if (ok)
+				options.seeded = true;
+		}
+		else if (arg == "--autopilot")
+			options.autopilot = true;
+		else if (hasValue(arg, "--record", value))
+			options.recordFile = value;
+		else if (hasValue(arg, "--replay", value))
+			options.replayFile = value;
+		else if (arg == "--headless")
+			options.headless = true;
+		else if (hasValue(arg, "--headless", value))
+		{
+			options.headless = true;
+			ok = toInt(value, 1, options.headlessTicks);
+		}
+		else if (hasValue(arg, "--dump", value))
+			options.dumpPrefix = value;
+		else if (hasValue(arg, "--dump-every", value))
+			ok = toInt(value, 1, options.dumpEvery);
+		else if (hasValue(arg, "--renderer", value))
+		{
+			ok = (value == "gl"  ||  value == "software");
+			options.softwareRenderer = (value == "software");
+		}
+		else if (hasValue(arg, "--threads", value))
+			ok = toInt(value, 0, options.threads);
+		else if (hasValue(arg, "--batch", value))
+			ok = toInt(value, 1, options.batchWorlds);
+		else if (hasValue(arg, "--grid", value))
+		{
+			size_t x = value.find('x');
+			ok = x != string::npos  &&
+				 toInt(value.substr(0, x), 1, options.gridWidth)  &&
+				 toInt(value.substr(x + 1), 1, options.gridHeight);
+		}
+		else if (hasValue(arg, "--event-log", value))
+			options.eventLog = value;
+		else if (hasValue(arg, "--trace", value))
+			options.traceFile = value;
+		else if (hasValue(arg, "--profile", value))
+			options.profileFile = value;
+		else if (arg == "--watchdog")
+			options.watchdog = true;
+		else if (hasValue(arg, "--watchdog", value))
+		{
+			options.watchdog = true;
+			ok = toInt(value, 0, options.watchdogMs);
+		}
+		else if (hasValue(arg, "--watchdog-keys", value))
+		{
+			options.watchdog = true;
+			options.watchdogKeys = value;
+		}
+		else if (arg == "--alloc-check")
+			options.allocCheck = true;
+		else if (hasValue(arg, "--alloc-check", value))
+		{
+			options.allocCheck = true;
+			ok = toInt(value, 0, options.allocCheckWarmup);
+		}
+		else if (arg == "--actor-stats")
+			options.actorStats = true;
+		else
+		{
+			error = "Unknown option " + arg;
+			return false;
+		}
+
+		if (!ok)
+		{
+			error = "Bad value in " + arg;
+			return false;
+		}
+	}
+
+	if (!options.recordFile.empty()  &&  !options.replayFile.empty())
+	{
+		error = "--record and --replay can't be used together";
+		return false;
+	}
+	return true;
+}
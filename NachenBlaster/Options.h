@@ -0,0 +1,66 @@
+#ifndef OPTIONS_H_
+#define OPTIONS_H_
+
+#include <iosfwd>
+#include <string>
+
+  // Everything that can be set from the command line.  The defaults are
+  // what the game always did before there were options.
+
+struct Options
+{
+	Options();
+
+	  // Display and pacing
+	int			windowWidth;
+	int			windowHeight;
+	int			msPerFrame;		// how often the window is redrawn
+	double		ticksPerSecond;
+	int			ticksPerFrame;	// turbo mode (see GameController::setTurbo)
+	bool		unthrottled;
+	bool		interpolate;	// draw objects between where they were on the last two ticks
+	bool		cachedBackground;	// draw the background from one scrolling texture (see BackgroundLayer.h)
+	int			internalHeight;	// if not 0, draw sprites this many pixels high and scale them up (see UpscaledTarget.h)
+	int			quality;		// cosmetic detail (see GameWorld::setQuality); -1 means adjust to the frame time
+	bool		qualityGiven;	// if false, headless runs use QUALITY_MAX so they play the same every time
+
+	  // Game
+	std::string assetDirectory;
+	bool		seeded;			// if false, the seed is picked at random
+	unsigned int seed;
+	bool		autopilot;
+	std::string recordFile;		// save every key the game handles, with the seed
+	std::string replayFile;		// play back a file saved with recordFile
+
+	  // Headless runs (see GameController::runHeadless)
+	bool		headless;
+	int			headlessTicks;
+	std::string dumpPrefix;
+	int			dumpEvery;
+	bool		softwareRenderer;
+	int			threads;		// for the software renderer and batches; 0 means one per core
+	int			batchWorlds;	// if not 0, benchmark a BatchEnv of this many worlds instead of playing
+	int			gridWidth;		// if not 0, the batch also rasterizes occupancy grids this size
+	int			gridHeight;
+
+	  // Diagnostics
+	std::string eventLog;		// see EventLog.h
+	std::string traceFile;		// see WorldTrace.h
+	std::string profileFile;	// per-tick and per-frame timings, as CSV
+	bool		watchdog;		// report ticks and frames that go over budget
+	int			watchdogMs;		// the budget; -1 means the tick interval for ticks, msPerFrame for frames
+	std::string watchdogKeys;	// save a recording up to each slow tick as this prefix + tick + ".keys"
+	bool		allocCheck;		// report every tick past the warm-up that allocates
+	int			allocCheckWarmup;	// ticks at the start of the game that may allocate
+	bool		actorStats;		// report live and peak Actors, by type, at the end of each level
+	bool		help;
+};
+
+  // Fills in options from the command line.  Arguments that don't start
+  // with "--" are left for GLUT (e.g., -display).  Returns false, with a
+  // message in error, if an option isn't recognized or its value is bad.
+bool parseOptions(int argc, char* argv[], Options& options, std::string& error);
+
+void printUsage(std::ostream& out, const char* program);
+
+#endif // OPTIONS_H_
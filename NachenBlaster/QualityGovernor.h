@@ -0,0 +1,106 @@
+#ifndef QUALITYGOVERNOR_H_
+#define QUALITYGOVERNOR_H_
+
+#include "GameWorld.h"
+#include <chrono>
+
+  // Picks the quality level (see GameWorld::setQuality) from how long
+  // recent frames took to draw.  It steps down quickly once the smoothed
+  // frame time stays over budget, and back up slowly once it stays well
+  // under, so a level is never flipped back and forth from frame to frame.
+
+class QualityGovernor
+{
+public:
+	QualityGovernor()
+	{
+		configure(std::chrono::milliseconds(1), QUALITY_MAX, false);
+	}
+
+	  // If automatic is false, the level stays where it's put
+	void configure(std::chrono::steady_clock::duration budget, int level, bool automatic)
+	{
+		m_budgetMicros = std::chrono::duration<double, std::micro>(budget).count();
+		m_level = level < QUALITY_MIN ? QUALITY_MIN : (level > QUALITY_MAX ? QUALITY_MAX : level);
+		m_automatic = automatic;
+		m_changes = 0;
+		restart();
+	}
+
+	  // Takes how long the last frame took, and returns the level to use
+	  // from now on
+	int update(std::chrono::steady_clock::duration frameTime)
+	{
+		if (!m_automatic)
+			return m_level;
+
+		if (m_settleFrames > 0)
+		{
+			m_settleFrames--;
+			return m_level;
+		}
+		double micros = std::chrono::duration<double, std::micro>(frameTime).count();
+		m_averageMicros = (m_averageMicros < 0) ? micros : m_averageMicros + (micros - m_averageMicros) * SMOOTHING;
+
+		m_framesOver = (m_averageMicros > m_budgetMicros) ? m_framesOver + 1 : 0;
+		m_framesUnder = (m_averageMicros < m_budgetMicros * RAISE_BELOW) ? m_framesUnder + 1 : 0;
+		if (m_framesOver >= FRAMES_TO_LOWER  &&  m_level > QUALITY_MIN)
+			change(m_level - 1);
+		else if (m_framesUnder >= FRAMES_TO_RAISE  &&  m_level < QUALITY_MAX)
+			change(m_level + 1);
+		return m_level;
+	}
+
+	int level() const
+	{
+		return m_level;
+	}
+
+	bool isAutomatic() const
+	{
+		return m_automatic;
+	}
+
+	int changes() const
+	{
+		return m_changes;
+	}
+
+private:
+	  // The smoothed frame time follows each new frame this much of the way
+	static constexpr double SMOOTHING = 0.1;
+	  // Frames the smoothed time must stay over budget to step down, or
+	  // under RAISE_BELOW of it to step up
+	static const int FRAMES_TO_LOWER = 15;
+	static const int FRAMES_TO_RAISE = 300;
+	static constexpr double RAISE_BELOW = 0.5;
+	  // Frames ignored at the start (while everything warms up) and after a
+	  // change (while the new level's cost shows up)
+	static const int SETTLE_FRAMES = 30;
+
+	double	m_budgetMicros;
+	double	m_averageMicros;  // negative until the first frame is measured
+	int		m_level;
+	bool	m_automatic;
+	int		m_framesOver;
+	int		m_framesUnder;
+	int		m_settleFrames;
+	int		m_changes;
+
+	void restart()
+	{
+		m_averageMicros = -1;
+		m_framesOver = 0;
+		m_framesUnder = 0;
+		m_settleFrames = SETTLE_FRAMES;
+	}
+
+	void change(int level)
+	{
+		m_level = level;
+		m_changes++;
+		restart();
+	}
+};
+
+#endif // QUALITYGOVERNOR_H_
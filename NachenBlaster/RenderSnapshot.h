@@ -0,0 +1,104 @@
+#ifndef RENDERSNAPSHOT_H_
+#define RENDERSNAPSHOT_H_
+
+#include "InputQueue.h"
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+  // Everything needed to draw one object, copied out of its GraphObject.
+  // fromX, fromY, and fromAngle are where it was in the previous snapshot.
+
+struct RenderItem
+{
+	int			  imageID;
+	unsigned int  animationNumber;
+	float		  fromX;
+	float		  fromY;
+	float		  x;
+	float		  y;
+	short		  fromAngle;
+	short		  angle;
+	unsigned char depth;
+	float		  size;
+};
+
+  // Everything needed to draw one tick of the game.  The simulation fills
+  // one of these in after each tick so the renderer never has to look at
+  // live game objects.
+
+struct RenderSnapshot
+{
+	RenderSnapshot()
+	 : tick(0), tickInterval(0), backgroundScroll(0), fromBackgroundScroll(0), backgroundEpoch(0),
+	   hasInput(false)
+	{
+	}
+
+	unsigned long			tick;
+	std::chrono::steady_clock::time_point published;
+	std::chrono::steady_clock::duration tickInterval;  // until the next snapshot is due, or 0 if
+														// there's no telling (e.g., single-stepping)
+	std::vector<RenderItem> items;	  // in drawing order (back to front)
+	double					backgroundScroll;	  // see GameWorld::scrollBackground; fromBackgroundScroll
+	double					fromBackgroundScroll; // is what it was in the previous snapshot
+	unsigned int			backgroundEpoch;
+	std::string				statText;
+	std::string				turboText;	  // empty unless in turbo mode
+	bool					hasInput;	  // whether this tick handled any key presses,
+	InputClock::time_point	oldestInput; // and if so, when the earliest of them arrived
+};
+
+  // Lock-free triple buffer for passing the latest value from one writer
+  // thread to one reader thread.  The writer always has a buffer to fill and
+  // the reader always has a complete buffer to read, so neither ever waits;
+  // if the writer publishes faster than the reader reads, the reader just
+  // skips to the newest value.
+
+template<typename T>
+class TripleBuffer
+{
+public:
+	TripleBuffer()
+	 : m_write(0), m_read(1), m_ready(2)
+	{
+	}
+
+	  // Writer side
+	T& writeBuffer()
+	{
+		return m_buffers[m_write];
+	}
+
+	void publish()
+	{
+		m_write = m_ready.exchange(m_write | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+	}
+
+	  // Reader side.  Returns true if a newer value was published since the
+	  // last call, in which case readBuffer() now refers to it.
+	bool acquireLatest()
+	{
+		if ((m_ready.load(std::memory_order_acquire) & FRESH) == 0)
+			return false;
+		m_read = m_ready.exchange(m_read, std::memory_order_acq_rel) & INDEX_MASK;
+		return true;
+	}
+
+	const T& readBuffer() const
+	{
+		return m_buffers[m_read];
+	}
+
+private:
+	static const int INDEX_MASK = 3;
+	static const int FRESH		= 4;
+
+	T				 m_buffers[3];
+	int				 m_write;
+	int				 m_read;
+	std::atomic<int> m_ready;	// index of the spare buffer, plus FRESH if it holds unread data
+};
+
+#endif // RENDERSNAPSHOT_H_
@@ -0,0 +1,304 @@
+#include "SoftwareRenderer.h"
+#include "TGAImage.h"
+#include <algorithm>
+#include <cmath>
+using namespace std;
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SOFTWARE_RENDERER_SSE2
+#endif
+
+static const int MAX_FRAMES_PER_SPRITE = 100;
+
+static int textureKey(int imageID, int frame)
+{
+	return imageID * MAX_FRAMES_PER_SPRITE + frame;
+}
+
+SoftwareRenderer::SoftwareRenderer(int width, int height, int threads)
+ : m_width(width), m_height(height),
+   m_tilesX((width + TILE_SIZE - 1) / TILE_SIZE), m_tilesY((height + TILE_SIZE - 1) / TILE_SIZE),
+   m_pixels(static_cast<size_t>(width) * height * 4), m_bins(m_tilesX * m_tilesY),
+   m_generation(0), m_busyWorkers(0), m_quit(false), m_nextTile(0)
+{
+	if (threads <= 0)
+		threads = max(1u, thread::hardware_concurrency());
+
+	  // The thread calling endFrame() does its share of the work too
+	for (int k = 1; k < threads; k++)
+		m_workers.push_back(thread(&SoftwareRenderer::workerLoop, this));
+}
+
+SoftwareRenderer::~SoftwareRenderer()
+{
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_quit = true;
+	}
+	m_startCV.notify_all();
+	for (thread& t : m_workers)
+		t.join();
+}
+
+bool SoftwareRenderer::loadSprite(string filename_tga, int imageID, int frameNum)
+{
+	if (frameNum >= MAX_FRAMES_PER_SPRITE)
+		return false;
+
+	TGAImage image;
+	if (!readTGA(filename_tga, image))
+		return false;
+
+	Texture& texture = m_textures[textureKey(imageID, frameNum)];
+	texture.width = image.width;
+	texture.height = image.height;
+	texture.texels.resize(static_cast<size_t>(image.width) * image.height);
+	for (size_t k = 0; k < texture.texels.size(); k++)
+	{
+		const unsigned char* p = &image.data[k * image.byteCount];
+		uint32_t alpha = (image.byteCount == 4 ? p[3] : 255);
+		texture.texels[k] = p[0] | (p[1] << 8) | (p[2] << 16) | (alpha << 24);
+	}
+
+	m_frameCountPerSprite[imageID]++;
+	return true;
+}
+
+int SoftwareRenderer::getNumFrames(int imageID) const
+{
+	auto it = m_frameCountPerSprite.find(imageID);
+	if (it == m_frameCountPerSprite.end())
+		return 0;
+
+	return it->second;
+}
+
+void SoftwareRenderer::beginFrame()
+{
+	m_quads.clear();
+	for (vector<int>& bin : m_bins)
+		bin.clear();
+}
+
+bool SoftwareRenderer::plotSprite(int imageID, int frame, double x, double y, int angleDegrees, double size)
+{
+	auto it = m_textures.find(textureKey(imageID, frame));
+	if (it == m_textures.end())
+		return false;
+
+	  // Sprites are SPRITE_WIDTH x SPRITE_HEIGHT game units at size 1, centered on (x, y)
+	double scaleX = static_cast<double>(m_width) / VIEW_WIDTH;
+	double scaleY = static_cast<double>(m_height) / VIEW_HEIGHT;
+	double cx = x * scaleX;
+	double cy = y * scaleY;
+	double w = SPRITE_WIDTH * size * scaleX;
+	double h = SPRITE_HEIGHT * size * scaleY;
+	if (w <= 0 || h <= 0)
+		return false;
+
+	static const double PI = 4 * atan(1.0);
+	double theta = angleDegrees * PI / 180;
+	double c = cos(theta);
+	double s = sin(theta);
+
+	  // Inverse of "scale to w x h, rotate by theta, move to (cx, cy)", sampled at pixel centers
+	Quad q;
+	q.texture = &it->second;
+	q.dudx = static_cast<float>(c / w);
+	q.dudy = static_cast<float>(s / w);
+	q.dvdx = static_cast<float>(-s / h);
+	q.dvdy = static_cast<float>(c / h);
+	q.u0 = static_cast<float>(0.5 + ((0.5 - cx) * c + (0.5 - cy) * s) / w);
+	q.v0 = static_cast<float>(0.5 + (-(0.5 - cx) * s + (0.5 - cy) * c) / h);
+
+	double extentX = (abs(c) * w + abs(s) * h) / 2;
+	double extentY = (abs(s) * w + abs(c) * h) / 2;
+	q.minX = max(0, static_cast<int>(floor(cx - extentX)));
+	q.minY = max(0, static_cast<int>(floor(cy - extentY)));
+	q.maxX = min(m_width - 1, static_cast<int>(ceil(cx + extentX)));
+	q.maxY = min(m_height - 1, static_cast<int>(ceil(cy + extentY)));
+	if (q.minX > q.maxX || q.minY > q.maxY)
+		return true;	// entirely offscreen
+
+	int index = static_cast<int>(m_quads.size());
+	m_quads.push_back(q);
+	for (int ty = q.minY / TILE_SIZE; ty <= q.maxY / TILE_SIZE; ty++)
+		for (int tx = q.minX / TILE_SIZE; tx <= q.maxX / TILE_SIZE; tx++)
+			m_bins[ty * m_tilesX + tx].push_back(index);
+	return true;
+}
+
+void SoftwareRenderer::endFrame()
+{
+	m_nextTile = 0;
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_generation++;
+		m_busyWorkers = static_cast<int>(m_workers.size());
+	}
+	m_startCV.notify_all();
+
+	rasterizeTiles();
+
+	unique_lock<mutex> lock(m_mutex);
+	m_doneCV.wait(lock, [this] { return m_busyWorkers == 0; });
+}
+
+void SoftwareRenderer::workerLoop()
+{
+	unsigned long seen = 0;
+	for (;;)
+	{
+		{
+			unique_lock<mutex> lock(m_mutex);
+			m_startCV.wait(lock, [&] { return m_quit || m_generation != seen; });
+			if (m_quit)
+				return;
+			seen = m_generation;
+		}
+
+		rasterizeTiles();
+
+		lock_guard<mutex> lock(m_mutex);
+		if (--m_busyWorkers == 0)
+			m_doneCV.notify_one();
+	}
+}
+
+void SoftwareRenderer::rasterizeTiles()
+{
+	int numTiles = m_tilesX * m_tilesY;
+	for (int tile = m_nextTile++; tile < numTiles; tile = m_nextTile++)
+		rasterizeTile(tile);
+}
+
+void SoftwareRenderer::rasterizeTile(int tile)
+{
+	int x0 = (tile % m_tilesX) * TILE_SIZE;
+	int y0 = (tile / m_tilesX) * TILE_SIZE;
+	int x1 = min(x0 + TILE_SIZE, m_width) - 1;
+	int y1 = min(y0 + TILE_SIZE, m_height) - 1;
+
+	  // Clear to opaque black
+	for (int y = y0; y <= y1; y++)
+	{
+		uint32_t* row = reinterpret_cast<uint32_t*>(&m_pixels[(static_cast<size_t>(y) * m_width + x0) * 4]);
+		fill(row, row + (x1 - x0 + 1), 0xFF000000u);
+	}
+
+	for (int index : m_bins[tile])
+	{
+		const Quad& q = m_quads[index];
+		rasterizeQuad(q, max(x0, q.minX), max(y0, q.minY), min(x1, q.maxX), min(y1, q.maxY));
+	}
+}
+
+  // Standard "source over" blending, the same as GL_SRC_ALPHA,
+  // GL_ONE_MINUS_SRC_ALPHA: each channel becomes (s*a + d*(255-a)) / 255,
+  // rounded to nearest.  x/255 is computed exactly as (x + 128 + ((x + 128) >> 8)) >> 8.
+
+static inline uint32_t blendPixel(uint32_t src, uint32_t dst)
+{
+	uint32_t a = src >> 24;
+	uint32_t out = 0;
+	for (int shift = 0; shift < 32; shift += 8)
+	{
+		uint32_t x = ((src >> shift) & 0xFF) * a + ((dst >> shift) & 0xFF) * (255 - a) + 128;
+		out |= (((x + (x >> 8)) >> 8) & 0xFF) << shift;
+	}
+	return out;
+}
+
+#ifdef SOFTWARE_RENDERER_SSE2
+
+  // Blends 4 source pixels over 4 destination pixels
+static inline __m128i blendPixels(__m128i src, __m128i dst)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i all255 = _mm_set1_epi16(255);
+	const __m128i half = _mm_set1_epi16(128);
+
+	__m128i srcLo = _mm_unpacklo_epi8(src, zero);
+	__m128i srcHi = _mm_unpackhi_epi8(src, zero);
+	__m128i dstLo = _mm_unpacklo_epi8(dst, zero);
+	__m128i dstHi = _mm_unpackhi_epi8(dst, zero);
+
+	  // Spread each pixel's alpha across its four channels
+	__m128i alphaLo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(srcLo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+	__m128i alphaHi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(srcHi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+	  // At most 255*255 + 128, which still fits in an unsigned 16-bit lane
+	__m128i lo = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(srcLo, alphaLo),
+											 _mm_mullo_epi16(dstLo, _mm_sub_epi16(all255, alphaLo))), half);
+	__m128i hi = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(srcHi, alphaHi),
+											 _mm_mullo_epi16(dstHi, _mm_sub_epi16(all255, alphaHi))), half);
+	lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+	hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+	return _mm_packus_epi16(lo, hi);
+}
+
+#endif
+
+void SoftwareRenderer::rasterizeQuad(const Quad& q, int x0, int y0, int x1, int y1)
+{
+	const Texture& tex = *q.texture;
+	const float texW = static_cast<float>(tex.width);
+	const float texH = static_cast<float>(tex.height);
+
+	for (int y = y0; y <= y1; y++)
+	{
+		uint32_t* row = reinterpret_cast<uint32_t*>(&m_pixels[static_cast<size_t>(y) * m_width * 4]);
+		float uRow = q.u0 + y * q.dudy;
+		float vRow = q.v0 + y * q.dvdy;
+		int x = x0;
+
+#ifdef SOFTWARE_RENDERER_SSE2
+		const __m128 steps = _mm_set_ps(3, 2, 1, 0);
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1);
+		const __m128 dudx = _mm_set1_ps(q.dudx);
+		const __m128 dvdx = _mm_set1_ps(q.dvdx);
+		for ( ; x + 3 <= x1; x += 4)
+		{
+			__m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), steps);
+			__m128 u = _mm_add_ps(_mm_set1_ps(uRow), _mm_mul_ps(px, dudx));
+			__m128 v = _mm_add_ps(_mm_set1_ps(vRow), _mm_mul_ps(px, dvdx));
+			int inside = _mm_movemask_ps(_mm_and_ps(_mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmplt_ps(u, one)),
+													_mm_and_ps(_mm_cmpge_ps(v, zero), _mm_cmplt_ps(v, one))));
+			if (inside == 0)
+				continue;
+
+			alignas(16) int tx[4];
+			alignas(16) int ty[4];
+			_mm_store_si128(reinterpret_cast<__m128i*>(tx), _mm_cvttps_epi32(_mm_mul_ps(u, _mm_set1_ps(texW))));
+			_mm_store_si128(reinterpret_cast<__m128i*>(ty), _mm_cvttps_epi32(_mm_mul_ps(v, _mm_set1_ps(texH))));
+
+			  // Outside the sprite, a fully transparent texel leaves the pixel alone
+			alignas(16) uint32_t texels[4];
+			for (int k = 0; k < 4; k++)
+			{
+				if (inside & (1 << k))
+					texels[k] = tex.texels[min(ty[k], tex.height - 1) * tex.width + min(tx[k], tex.width - 1)];
+				else
+					texels[k] = 0;
+			}
+
+			__m128i dst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x));
+			__m128i src = _mm_load_si128(reinterpret_cast<const __m128i*>(texels));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(row + x), blendPixels(src, dst));
+		}
+#endif
+
+		for ( ; x <= x1; x++)
+		{
+			float u = uRow + x * q.dudx;
+			float v = vRow + x * q.dvdx;
+			if (u < 0 || u >= 1 || v < 0 || v >= 1)
+				continue;
+			int tx = min(static_cast<int>(u * texW), tex.width - 1);
+			int ty = min(static_cast<int>(v * texH), tex.height - 1);
+			row[x] = blendPixel(tex.texels[ty * tex.width + tx], row[x]);
+		}
+	}
+}
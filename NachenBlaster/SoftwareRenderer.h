@@ -0,0 +1,95 @@
+#ifndef SOFTWARERENDERER_H_
+#define SOFTWARERENDERER_H_
+
+#include "GameConstants.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+  // A CPU renderer with the same sprite interface as SpriteManager.  Sprites
+  // plotted between beginFrame() and endFrame() are binned into screen tiles,
+  // and endFrame() rasterizes the tiles in parallel, blending each span of
+  // pixels with SIMD where it's available.  Every tile is drawn by exactly one
+  // thread in plotting order, so the output is the same on every run and on
+  // every machine, which makes it usable for captures and tests without any
+  // GL at all.
+  //
+  // Game coordinates are mapped straight onto the framebuffer (no
+  // perspective), so frames won't match the GL renderer pixel for pixel.
+
+class SoftwareRenderer
+{
+public:
+	  // threads == 0 means one thread per core
+	SoftwareRenderer(int width, int height, int threads = 0);
+	~SoftwareRenderer();
+
+	bool loadSprite(std::string filename_tga, int imageID, int frameNum);
+	int getNumFrames(int imageID) const;
+	bool plotSprite(int imageID, int frame, double x, double y, int angleDegrees, double size);
+
+	void beginFrame();
+	void endFrame();
+
+	  // The finished frame, as BGRA pixels with the bottom row first
+	const std::vector<unsigned char>& pixels() const { return m_pixels; }
+	int width() const  { return m_width; }
+	int height() const { return m_height; }
+
+private:
+	struct Texture
+	{
+		int					  width;
+		int					  height;
+		std::vector<uint32_t> texels;	// BGRA, bottom row first
+	};
+
+	  // A sprite placed on the screen.  A pixel at (px, py) samples the
+	  // texture at u = u0 + px*dudx + py*dudy (and likewise for v), and is
+	  // inside the sprite if 0 <= u, v < 1.
+	struct Quad
+	{
+		const Texture* texture;
+		float u0, dudx, dudy;
+		float v0, dvdx, dvdy;
+		int	  minX, minY, maxX, maxY;	// bounding box, inclusive
+	};
+
+	static const int TILE_SIZE = 64;
+
+	int						   m_width;
+	int						   m_height;
+	int						   m_tilesX;
+	int						   m_tilesY;
+	std::vector<unsigned char> m_pixels;
+	std::map<int, Texture>	   m_textures;
+	std::map<int, int>		   m_frameCountPerSprite;
+	std::vector<Quad>		   m_quads;
+	std::vector<std::vector<int>> m_bins;	// indexes into m_quads for each tile
+
+	  // Worker threads wait for m_generation to change, then take tiles
+	  // from m_nextTile until there are none left
+	std::vector<std::thread> m_workers;
+	std::mutex				 m_mutex;
+	std::condition_variable	 m_startCV;
+	std::condition_variable	 m_doneCV;
+	unsigned long			 m_generation;
+	int						 m_busyWorkers;
+	bool					 m_quit;
+	std::atomic<int>		 m_nextTile;
+
+	void workerLoop();
+	void rasterizeTiles();
+	void rasterizeTile(int tile);
+	void rasterizeQuad(const Quad& q, int x0, int y0, int x1, int y1);
+
+	SoftwareRenderer(const SoftwareRenderer&) = delete;
+	SoftwareRenderer& operator=(const SoftwareRenderer&) = delete;
+};
+
+#endif // SOFTWARERENDERER_H_
@@ -13,7 +13,7 @@ class SoundFXController
 {
   public:
 
-	void playClip(std::string soundFile)
+	void playClip(const std::string& soundFile)
 	{
 		if (m_engine != nullptr)
 			m_engine->play2D(soundFile.c_str(), false);
@@ -52,8 +52,6 @@ class SoundFXController
 
 #include <spawn.h>
 #include <csignal>
-#include <cstring>
-#include <memory>
 #include <chrono>
 
 #include <iostream>
@@ -65,7 +63,7 @@ class SoundFXController
 	 : pidValid(false)
 	{}
 
-	void playClip(std::string soundFile)
+	void playClip(const std::string& soundFile)
 	{
 		  // Don't start a clip more than 2 times per second
 		static std::chrono::system_clock::time_point lastPlayTime;
@@ -74,10 +72,9 @@ class SoundFXController
 			return;
 		lastPlayTime = now;
 
+		  // posix_spawn doesn't modify argv, so the path needn't be copied
 		char cmd[] = "/usr/bin/afplay";
-		std::unique_ptr<char[]> fileName(new char[soundFile.size()+1]);
-		std::strcpy(fileName.get(), soundFile.c_str());
-		char* argv[] = { cmd, fileName.get(), nullptr };
+		char* argv[] = { cmd, const_cast<char*>(soundFile.c_str()), nullptr };
 		abortClip();  // stop anything currently playing
 		pidValid =
 		  (posix_spawn(&pid, argv[0], nullptr, nullptr, argv, nullptr) == 0);
@@ -102,7 +99,7 @@ class SoundFXController
 class SoundFXController
 {
   public:
-	void playClip(std::string) {}
+	void playClip(const std::string&) {}
 	void abortClip() {}
 	static SoundFXController& getInstance();
 };
@@ -12,6 +12,7 @@
 #endif
 
 #include "GameConstants.h"
+#include "TGAImage.h"
 #include <iostream>
 #include <fstream>
 #include <string>
@@ -39,6 +40,20 @@ public:
 		m_mipMapped = status;
 	}
 
+	  // Switches sprites loaded with mip-mapping between filtering through
+	  // the mipmaps and plain bilinear filtering of the full-size image, which
+	  // is cheaper to draw
+	void setMipmapFiltering(bool on)
+	{
+		if (!m_mipMapped)
+			return;
+		for (auto it = m_imageMap.begin(); it != m_imageMap.end(); it++)
+		{
+			glBindTexture(GL_TEXTURE_2D, it->second);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, on ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+		}
+	}
+
 	bool loadSprite(std::string filename_tga, int imageID, int frameNum)
 	{
 		  // Load Texture Data From TGA File
@@ -49,40 +64,13 @@ public:
 
 		m_frameCountPerSprite[imageID]++;	// keep track of how many frames per sprite we loaded
 
-		std::string line;
-		std::string contents = "";
-		std::ifstream tgaFile(filename_tga, std::ios::in|std::ios::binary);
-
-		if (!tgaFile)
-			return false;
-
-		char type[3];
-		char info[6];
-
-		  // Read file header info
-		tgaFile.read(type, 3);
-		tgaFile.seekg(12);
-		tgaFile.read(info, 6);
-		unsigned int textureWidth = static_cast<unsigned char>(info[0]) + static_cast<unsigned char>(info[1]) * 256;
-		unsigned int textureHeight = static_cast<unsigned char>(info[2]) + static_cast<unsigned char>(info[3]) * 256;
-		unsigned char byteCount = static_cast<unsigned char>(info[4]) / 8;
-		long imageSize = textureWidth * textureHeight * byteCount;
-		char* imageData = new char[imageSize];
-		tgaFile.seekg(18);
-		  // Read image data
-		tgaFile.read(imageData, imageSize);
-		if (!tgaFile)
-		{
-			delete [] imageData;
-			return false;
-		}
-
-		  //image type either 2 (color) or 3 (greyscale)
-		if (type[1] != 0 || (type[2] != 2 && type[2] != 3))
-			return false;
-
-		if (byteCount != 3 && byteCount != 4)
+		TGAImage image;
+		if (!readTGA(filename_tga, image))
 			return false;
+		unsigned int textureWidth = image.width;
+		unsigned int textureHeight = image.height;
+		unsigned char byteCount = image.byteCount;
+		char* imageData = reinterpret_cast<char*>(image.data.data());
 
 		  // Transfer Texture To OpenGL
 
@@ -129,8 +117,6 @@ public:
 				glTexImage2D(GL_TEXTURE_2D, 0, 4, textureWidth, textureHeight, 0, GL_BGRA, GL_UNSIGNED_BYTE, imageData);
 		}
 
-		delete [] imageData;
-
 		m_imageMap[spriteID] = glTextureID;
 
 		return true;
@@ -226,6 +212,17 @@ public:
 		return true;
 	}
 
+	  // Where a point in the game world is in OpenGL coordinates; every sprite
+	  // is in the same plane
+    static void convertToGlutCoords(double x, double y, double& gx, double& gy, double& gz)
+    {
+        x /= VIEW_WIDTH;
+        y /= VIEW_HEIGHT;
+        gx = 2 * VISIBLE_MIN_X + .3 + x * 2 * (VISIBLE_MAX_X - VISIBLE_MIN_X);
+        gy = 2 * VISIBLE_MIN_Y +      y * 2 * (VISIBLE_MAX_Y - VISIBLE_MIN_Y);
+        gz = .6 * VISIBLE_MIN_Z;
+    }
+
 	~SpriteManager()
 	{
 		for (auto it = m_imageMap.begin(); it != m_imageMap.end(); it++)
@@ -241,15 +238,6 @@ private:
 		xout = x * cos(theta) - y * sin(theta);
 		yout = y * cos(theta) + x * sin(theta);
 	}
-    
-    static void convertToGlutCoords(double x, double y, double& gx, double& gy, double& gz)
-    {
-        x /= VIEW_WIDTH;
-        y /= VIEW_HEIGHT;
-        gx = 2 * VISIBLE_MIN_X + .3 + x * 2 * (VISIBLE_MAX_X - VISIBLE_MIN_X);
-        gy = 2 * VISIBLE_MIN_Y +      y * 2 * (VISIBLE_MAX_Y - VISIBLE_MIN_Y);
-        gz = .6 * VISIBLE_MIN_Z;
-    }
 
 	bool					m_mipMapped;
 	std::map<int, GLuint>	m_imageMap;
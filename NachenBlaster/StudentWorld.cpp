@@ -2,23 +2,64 @@
 #include "StudentWorld.h"
 #include "GameConstants.h"
 #include <string>
-#include <list>
+#include <vector>
 #include <iostream>
-#include <sstream>
-#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
 using namespace std;
 
-using it = std::list<Actor*>::iterator;
-const string sep = "  "; // Separator in the text at the top of the screen
+const char* const sep = "  "; // Separator in the text at the top of the screen
 
 GameWorld* createStudentWorld(string assetDir)
 {
 	return new StudentWorld(assetDir);
 }
 
+const int StudentWorld::GROUP_LAYERS[NUM_GROUPS] =
+{
+    LAYER_PLAYER_SHOTS, // GROUP_PLAYER_SHOTS
+    LAYER_ALIEN_SHOTS,  // GROUP_ALIEN_SHOTS
+    LAYER_GOODIES,      // GROUP_GOODIES
+    LAYER_NONE,         // GROUP_SCENERY
+    LAYER_ALIENS,       // GROUP_SMALLGONS
+    LAYER_ALIENS,       // GROUP_SMOREGONS
+    LAYER_ALIENS,       // GROUP_SNAGGLEGONS
+};
+
+// Room set aside for each kind of Actor before every level, a few times more than long autopilot
+// games ever have alive at once, so that spawning during play doesn't go to the heap
+static const ActorPool::Reservation RESERVED_ACTORS[] =
+{
+    { sizeof(Blaster),         1 },
+    { sizeof(Star),            64 },
+    { sizeof(Explosion),       16 },
+    { sizeof(Cabbage),         32 },
+    { sizeof(Turnip),          32 },
+    { sizeof(Torpedo),         32 },
+    { sizeof(Smallgon),        16 },
+    { sizeof(Smoregon),        16 },
+    { sizeof(Snagglegon),      16 },
+    { sizeof(ExtraLifeGoodie), 4 },
+    { sizeof(RepairGoodie),    4 },
+    { sizeof(TorpedoGoodie),   4 },
+};
+// How many Stars there are at each quality level, as a percentage of the full count
+static const int STAR_PERCENT[QUALITY_MAX + 1] = { 0, 33, 66, 100 };
+
+static const int RESERVED_PER_GROUP = 64;  // Likewise for the storage the Actors go in. Keep
+static const int RESERVED_HANDLES   = 128; // these small: a BatchEnv has thousands of worlds
+
 StudentWorld::StudentWorld(string assetDir)
-: GameWorld(assetDir)
-{}
+: GameWorld(assetDir), m_blaster(nullptr)
+{
+    for (vector<Actor*>& group : m_groups)
+        group.reserve(RESERVED_PER_GROUP);
+    m_slots.reserve(RESERVED_HANDLES);
+    m_spawns.reserve(RESERVED_PER_GROUP);
+    m_deaths.reserve(RESERVED_PER_GROUP);
+    m_statText.reserve(STAT_TEXT_SIZE);
+}
 
 StudentWorld::~StudentWorld()
 {
@@ -27,10 +68,13 @@ StudentWorld::~StudentWorld()
 
 int StudentWorld::init()
 {
+    ActorPool::reserve(RESERVED_ACTORS, sizeof(RESERVED_ACTORS) / sizeof(RESERVED_ACTORS[0]));
     m_blaster = new Blaster(this);
-    m_actors.push_front(m_blaster);
-    for (int i = 0; i < STARTING_STARS; i++)
-        m_actors.push_back(new Star(this, true));
+    restartBackground();
+    int stars = STARTING_STARS * starPercent() / 100;
+    for (int i = 0; i < stars; i++)
+        spawn(new Star(this, true), GROUP_SCENERY);
+    applyCommands();
     
     // The same S1, S2, and S3 as in the spec used to figure out
     // how to generate Aliens
@@ -41,81 +85,152 @@ int StudentWorld::init()
     m_destroyedAliens = 0;
     m_aliensOnScreen = 0;
     
+    recordEvent(EVENT_LEVEL_START, IID_NACHENBLASTER, getLives(), m_blaster->getX(), m_blaster->getY());
     return GWSTATUS_CONTINUE_GAME;
 }
 
 int StudentWorld::move()
 {
-    // Do stuff and clear dead actors other than the player
-    for (it i = m_actors.begin(); i != m_actors.end(); i++)
+    m_tickStats.begin(isTickTiming());
+    
+    // The autopilot presses its keys before the Blaster reads them
+    if (isAutopilot())
+        m_autopilot.plan(this);
+    m_tickStats.endPhase("autopilot");
+    
+    int status = tick();
+    
+    // Everything spawned or killed during the tick takes effect now, all at once
+    applyCommands();
+    m_tickStats.endPhase("commands");
+    if (isTracing())
     {
-        (*i)->doSomething();
-        if (!(*i)->isAlive() && *i != m_blaster)
-        {
-            if ((*i)->isAlien())
-                m_aliensOnScreen--;
-            delete *i;
-            i = m_actors.erase(i);
-            if (i != m_actors.begin() && i != m_actors.end())
-                i--;
-        }
+        traceState();
+        m_tickStats.endPhase("trace");
     }
+    m_actorStats.endTick();
+    endTick();
+    return status;
+}
+
+int StudentWorld::tick()
+{
+    // The Blaster always moves before anything else, and the shots it just fired move this tick
+    // too, as they did when they were put right after it in one list of Actors
+    m_blaster->doSomething();
+    applyCommands();
+    m_tickStats.endPhase("blaster");
+    
+    // Everything else updates group by group: every Alien, kind by kind, then the player's shots,
+    // the aliens' shots, goodies, and scenery. This is deliberately not the original order, which
+    // was one list with the newest Actors first, so it decides differently who wins when two
+    // Actors collide on the same tick and consumes randInt() in a different order. A seeded game
+    // plays out differently than it did with that list, but the same way every time
+    Smallgon::updateBatch(m_groups[GROUP_SMALLGONS]);
+    Smoregon::updateBatch(m_groups[GROUP_SMOREGONS]);
+    Snagglegon::updateBatch(m_groups[GROUP_SNAGGLEGONS]);
+    m_tickStats.endPhase("aliens");
+    
+    const int others[] = { GROUP_PLAYER_SHOTS, GROUP_ALIEN_SHOTS, GROUP_GOODIES, GROUP_SCENERY };
+    for (int group : others)
+        for (Actor* actor : m_groups[group])
+            actor->doSomething();
+    scrollBackground(STAR_SPEED);  // every Star just moved left by this much
+    m_tickStats.endPhase("others");
 
     // Check if the player has died
     if (!m_blaster->isAlive())
     {
         decLives();
+        recordEvent(EVENT_LEVEL_END, IID_NACHENBLASTER, GWSTATUS_PLAYER_DIED, m_blaster->getX(), m_blaster->getY());
         return GWSTATUS_PLAYER_DIED;
     }
     
-    // Generate stars
-    if (randInt(1, 15) == 1)
-        m_actors.push_back(new Star(this));
+    // Generate stars, fewer of them at lower quality
+    if (cosmeticRandInt(1, STAR_SPAWN_ODDS * 100) <= starPercent())
+        spawn(new Star(this), GROUP_SCENERY);
     
-    // Check if enough aliens are dead
-    if (remainingAliens() == 0)
+    // Check if enough aliens are dead. More than one can die in a tick, so this can overshoot
+    if (remainingAliens() <= 0)
     {
         playSound(SOUND_FINISHED_LEVEL);
+        recordEvent(EVENT_LEVEL_END, IID_NACHENBLASTER, GWSTATUS_FINISHED_LEVEL, m_blaster->getX(), m_blaster->getY());
         return GWSTATUS_FINISHED_LEVEL;
     }
     
     // Generate aliens
     if (m_aliensOnScreen < remainingAliens() && m_aliensOnScreen < maxAliens()-1)
     {
-        it i = m_actors.begin();
-        i++;
-        
         int num = randInt(1, m_S1 + m_S2 + m_S3);
         if (num <= m_S1)
-            m_actors.insert(i, new Smallgon(this));
+            spawn(new Smallgon(this), GROUP_SMALLGONS);
         else if (num <= m_S1 + m_S2)
-            m_actors.insert(i, new Smoregon(this));
+            spawn(new Smoregon(this), GROUP_SMOREGONS);
         else
-            m_actors.insert(i, new Snagglegon(this));
+            spawn(new Snagglegon(this), GROUP_SNAGGLEGONS);
         m_aliensOnScreen++;
     }
     
-    // Update display text
-    ostringstream oss;
-    oss.setf(ios::fixed);
-    oss.precision(0);
-    oss << "Lives: "     << getLives()                                          << sep;
-    oss << "Health: "    << setw(3) << m_blaster->getHealth() / 50 * 100 << "%" << sep;
-    oss << "Score: "     << getScore()                                          << sep;
-    oss << "Level: "     << getLevel()                                          << sep;
-    oss << "Cabbages: "  << setw(3) << m_blaster->getEnergy() / 30 * 100 << "%" << sep;
-    oss << "Torpedoes: " << m_blaster->getTorpedoes();
-    setGameStatText(oss.str());
+    // Update display text, unless nobody will ever see it
+    if (hasController())
+        updateStatText();
+    m_tickStats.endPhase("spawn+hud");
     
     return GWSTATUS_CONTINUE_GAME;
 }
 
+// Formatted into a buffer the world keeps, so the text costs no allocations once it has been as
+// long as it will get
+void StudentWorld::updateStatText()
+{
+    char text[STAT_TEXT_SIZE];
+    int length = snprintf(text, sizeof(text), "Lives: %u%sHealth: %3.0f%%%sScore: %u%sLevel: %u%sCabbages: %3.0f%%%sTorpedoes: %.0f",
+                          getLives(), sep, m_blaster->getHealth() / 50 * 100, sep, getScore(), sep,
+                          getLevel(), sep, m_blaster->getEnergy() / 30 * 100, sep, m_blaster->getTorpedoes());
+    m_statText.assign(text, min(length, STAT_TEXT_SIZE - 1));
+    setGameStatText(m_statText);
+}
+
 void StudentWorld::cleanUp()
 {
+    delete m_blaster;
     m_blaster = nullptr;
-    for (it i = m_actors.begin(); i != m_actors.end(); i++)
-        delete *i;
-    m_actors.clear();
+    for (vector<Actor*>& group : m_groups)
+    {
+        for (Actor* actor : group)
+            delete actor;
+        group.clear();
+    }
+    m_slots.clear();
+    for (Spawn& s : m_spawns)
+        delete s.actor;
+    m_spawns.clear();
+    m_deaths.clear();
+    
+#ifdef DEBUG
+    // Nothing should be left alive at the end of a level (--actor-stats shows what was)
+    if (m_actorStats.totalLive() != 0)
+        cout << "Actors outlived cleanUp!" << endl;
+#endif
+}
+
+int StudentWorld::starPercent() const
+{
+    return STAR_PERCENT[max(QUALITY_MIN, min(getQuality(), QUALITY_MAX))];
+}
+
+// Explains the tick that just ran: where its time went, and what was in the world
+void StudentWorld::describeTick(ostream& out) const
+{
+    m_tickStats.dump(out);
+    out << "  live actors:";
+    for (int id = 0; id < NUM_ACTOR_TYPES; id++)
+    {
+        const ActorTypeStats& t = m_actorStats.get(id);
+        if (t.name != nullptr && t.live > 0)
+            out << " " << t.name << " " << t.live;
+    }
+    out << endl;
 }
 
 // Checks for a collision between two actors
@@ -129,25 +244,234 @@ bool hasCollided(Actor* a1, Actor* a2)
     return false;
 }
 
-// Checks if a collision occurred for a certain Actor and puts it in the map
-// Also checks to make sure it doesn't collide with objects of the same type
-Actor* StudentWorld::findCollision(Actor* a)
+static Actor* findCollisionIn(Actor* a, const vector<Actor*>& group)
 {
-    for (it i = m_actors.begin(); i != m_actors.end(); i++)
+    for (Actor* other : group)
     {
-        // Collidable objects will be at the begin of the list, so we can end as soon as we hit an uncollidable one
-        if (!(*i)->isCollidable())
-            return nullptr;
-        if (a != *i && hasCollided(a, *i))
-            return *i;
+        // Actors that died this tick are still stored until the tick ends, but can't be hit
+        if (a != other && other->isAlive() && hasCollided(a, other))
+            return other;
     }
     return nullptr;
 }
 
+// How far along the segment from (x, y) to (x+dx, y+dy) a circle of the given radius first collides
+// with other, from 0 (at the start) to 1 (at the end), or -1 if it never does. Other is treated as
+// standing still, the same as in hasCollided()
+static double sweptHitTime(const double& x, const double& y, const double& dx, const double& dy,
+                           const double& radius, Actor* other)
+{
+    double reach = 0.75 * (radius + other->getRadius());
+    double fx = x - other->getX();
+    double fy = y - other->getY();
+    double c = fx * fx + fy * fy - reach * reach;
+    if (c < 0)
+        return 0;
+    
+    // Solve |f + t*d| = reach for the smaller t. Moving away from other (b >= 0) never hits
+    double a = dx * dx + dy * dy;
+    double b = fx * dx + fy * dy;
+    if (a == 0 || b >= 0)
+        return -1;
+    double discriminant = b * b - a * c;
+    if (discriminant < 0)
+        return -1;
+    double t = (-b - sqrt(discriminant)) / a;
+    return t <= 1 ? t : -1;
+}
+
+// Doesn't count as a query; the callers do that, each counting the Blaster as one candidate
+static bool collidesWithBlaster(Actor* a, Blaster* blaster)
+{
+    return a != blaster && blaster->isAlive() && hasCollided(a, blaster);
+}
+
+// Keeps track of whichever Actor a ran into earliest while sweeping from (fromX, fromY)
+static void sweepAgainst(Actor* a, const double& fromX, const double& fromY, Actor* other,
+                         Actor*& earliest, double& earliestTime)
+{
+    if (a == other || !other->isAlive())
+        return;
+    double t = sweptHitTime(fromX, fromY, a->getX() - fromX, a->getY() - fromY, a->getRadius(), other);
+    if (t >= 0 && (earliest == nullptr || t < earliestTime))
+    {
+        earliest = other;
+        earliestTime = t;
+    }
+}
+
+// Checks a against the Blaster alone. Actors that only ever interact with the player should use
+// this, since it never has to scan the rest of the world
+Blaster* StudentWorld::findBlasterCollision(Actor* a) const
+{
+    m_tickStats.countQuery(1);
+    return collidesWithBlaster(a, m_blaster) ? m_blaster : nullptr;
+}
+
+// Finds the first living Actor on one of the given layers that a collides with, checking the
+// Blaster first. Groups on other layers are never visited
+Actor* StudentWorld::findCollision(Actor* a, const int& layers)
+{
+    long candidates = (layers & LAYER_PLAYER) ? 1 : 0;
+    for (int group = 0; group < NUM_GROUPS; group++)
+    {
+        if (GROUP_LAYERS[group] & layers)
+            candidates += m_groups[group].size();
+    }
+    m_tickStats.countQuery(candidates);
+    
+    if ((layers & LAYER_PLAYER) && collidesWithBlaster(a, m_blaster))
+        return m_blaster;
+    
+    for (int group = 0; group < NUM_GROUPS; group++)
+    {
+        if ((GROUP_LAYERS[group] & layers) == 0)
+            continue;
+        Actor* collide = findCollisionIn(a, m_groups[group]);
+        if (collide != nullptr)
+            return collide;
+    }
+    return nullptr;
+}
+
+// Like findCollision(), but for an Actor that has just moved in a straight line from (fromX, fromY):
+// finds the living Actor on one of the given layers that a ran into first along the way
+Actor* StudentWorld::findSweptCollision(Actor* a, const double& fromX, const double& fromY, const int& layers)
+{
+    Actor* earliest = nullptr;
+    double earliestTime = 0;
+    long candidates = 0;
+    if (layers & LAYER_PLAYER)
+    {
+        sweepAgainst(a, fromX, fromY, m_blaster, earliest, earliestTime);
+        candidates++;
+    }
+    
+    for (int group = 0; group < NUM_GROUPS; group++)
+    {
+        if ((GROUP_LAYERS[group] & layers) == 0)
+            continue;
+        candidates += m_groups[group].size();
+        for (Actor* other : m_groups[group])
+            sweepAgainst(a, fromX, fromY, other, earliest, earliestTime);
+    }
+    m_tickStats.countQuery(candidates);
+    return earliest;
+}
+
+// Aliens are only ever spawned by the world itself, straight into their own groups
 void StudentWorld::addActor(Actor* actor)
 {
-    // We place the new Actor just past the Blaster
-    it i = m_actors.begin();
-    i++;
-    m_actors.insert(i, actor);
+    switch (actor->getLayer())
+    {
+        case LAYER_PLAYER_SHOTS: spawn(actor, GROUP_PLAYER_SHOTS); break;
+        case LAYER_ALIEN_SHOTS:  spawn(actor, GROUP_ALIEN_SHOTS);  break;
+        case LAYER_GOODIES:      spawn(actor, GROUP_GOODIES);      break;
+        default:                 spawn(actor, GROUP_SCENERY);      break;
+    }
+}
+
+void StudentWorld::removeActor(Actor* actor)
+{
+    // The Blaster isn't stored in a group; move() reports its death instead
+    if (actor == m_blaster)
+        return;
+    m_deaths.push_back(actor);
+    
+    // A dead Alien frees its place on screen right away, so a replacement can be generated later
+    // this same tick
+    if (actor->isAlien())
+        m_aliensOnScreen--;
+}
+
+// Dumps everything that decides how the game plays out from here into the trace
+void StudentWorld::traceState()
+{
+    TracedWorld world;
+    world.tick = getTick();
+    world.level = getLevel();
+    world.lives = getLives();
+    world.score = getScore();
+    world.energy = m_blaster->getEnergy();
+    world.torpedoes = static_cast<int>(m_blaster->getTorpedoes());
+    world.aliensDestroyed = m_destroyedAliens;
+    mt19937 next = randomGenerator(); // A copy, so tracing doesn't change what the game draws next
+    world.random = next();
+    trace().beginTick(world);
+    
+    auto traceActor = [this](const Actor* a)
+    {
+        TracedActor traced = { a->getImageID(), a->getX(), a->getY(), a->getDirection(), a->getSize(),
+                               0, 0, 0, 0, -1, 0 };
+        if (a->isAlien() || a->isPlayer())
+            traced.health = static_cast<const DamageableObject*>(a)->getHealth();
+        // Where an Alien is heading and who fired a projectile decide later ticks, so a change
+        // to either shows up in the tick it happens rather than once something has moved
+        if (a->isAlien())
+        {
+            const Alien* alien = static_cast<const Alien*>(a);
+            traced.plan = alien->getPlan();
+            traced.dy = alien->getDeltaY();
+            traced.speed = alien->getSpeed();
+        }
+        else if (a->isProjectile())
+        {
+            const Projectile* projectile = static_cast<const Projectile*>(a);
+            traced.shotBy = projectile->shotBy();
+            traced.damage = projectile->getDamage();
+        }
+        trace().addActor(traced);
+    };
+    // Scenery is left out: how much of it there is depends on the quality level, and none of it
+    // affects the game
+    traceActor(m_blaster);
+    for (int group = 0; group < NUM_GROUPS; group++)
+    {
+        if (group == GROUP_SCENERY)
+            continue;
+        for (const Actor* actor : m_groups[group])
+            traceActor(actor);
+    }
+    trace().endTick();
+}
+
+// The Actor a handle refers to, or nullptr if it has been removed from the world. Actors that died
+// this tick are still found until the tick is over, so callers should check isAlive()
+Actor* StudentWorld::resolve(const ActorHandle& handle) const
+{
+    const SlotMap::Location* location = m_slots.find(handle);
+    if (location == nullptr)
+        return nullptr;
+    return m_groups[location->group][location->slot];
+}
+
+void StudentWorld::spawn(Actor* actor, const int& group)
+{
+    m_spawns.push_back(Spawn{ actor, group });
+}
+
+void StudentWorld::applyCommands()
+{
+    for (const Spawn& s : m_spawns)
+    {
+        vector<Actor*>& group = m_groups[s.group];
+        s.actor->setHandle(m_slots.insert(s.group, static_cast<int>(group.size())));
+        group.push_back(s.actor);
+    }
+    m_spawns.clear();
+    
+    // Swap-and-pop: the last Actor in the group takes the dead one's slot. Its handle follows it,
+    // and the dead one's handle goes stale
+    for (Actor* actor : m_deaths)
+    {
+        SlotMap::Location dead = *m_slots.find(actor->getHandle());
+        vector<Actor*>& group = m_groups[dead.group];
+        Actor* last = group.back();
+        group[dead.slot] = last;
+        m_slots.move(last->getHandle(), dead.group, dead.slot);
+        group.pop_back();
+        m_slots.erase(actor->getHandle());
+        delete actor;
+    }
+    m_deaths.clear();
 }
@@ -2,14 +2,15 @@
 #define STUDENTWORLD_H_
 
 #include "GameWorld.h"
+#include "Actor.h"
+#include "ActorStats.h"
+#include "Autopilot.h"
 #include <string>
-#include <list>
+#include <vector>
 
-const int STARTING_STARS = 30;
-
-class Actor;
-class Blaster;
-class Projectile;
+const int STARTING_STARS  = 30; // At full quality; see starPercent()
+const int STAR_SPAWN_ODDS = 15; // One tick in this many spawns a Star, at full quality
+const int STAT_TEXT_SIZE = 128; // Longest text at the top of the screen, plus one
 
 class StudentWorld : public GameWorld
 {
@@ -19,28 +20,92 @@ public:
     virtual int init();
     virtual int move();
     virtual void cleanUp();
+    virtual void describeTick(std::ostream& out) const;
+    virtual void describeActors(std::ostream& out) const { m_actorStats.dump(out); }
     
         // Accessors
     void getBlasterPos(double& x, double& y) { x = m_blaster->getX(); y = m_blaster->getY(); };
     double remainingAliens() const { return 6 + 4 * getLevel() - m_destroyedAliens; };
     double maxAliens()       const { return 4 + 0.5 * getLevel(); };
+    ActorStats& actorStats()         { return m_actorStats; }
+    int  starPercent() const;
+    bool showsExplosions() const     { return getQuality() > QUALITY_MIN; }
+    const Blaster* getBlaster() const { return m_blaster; }
+    Actor* resolve(const ActorHandle& handle) const;
+    template<typename Func>
+    void forEachCollidable(const Func& f) const;
     
         // Mutators
     void   alienDied() { m_destroyedAliens++; }
     
         // Actor management
-    Actor* findCollision(Actor* a);
+        // Spawns and deaths are only recorded while the Actors are doing something, and are
+        // applied all at once at the end of the tick, so the storage never changes mid-update
+    Actor* findCollision(Actor* a, const int& layers);
+    Actor* findSweptCollision(Actor* a, const double& fromX, const double& fromY, const int& layers);
+    Blaster* findBlasterCollision(Actor* a) const;
     void addActor(Actor* actor);
+    void removeActor(Actor* actor);
 
 private:
-        // The Blaster is always the first Actor in the list so it takes priority with collisions
-        // Uncollidable objects are at the back, and collideable objects are at the front
+        // Every Actor other than the Blaster lives in exactly one group, and every group holds
+        // Actors from a single collision layer
+    enum Group
+    {
+        GROUP_PLAYER_SHOTS,
+        GROUP_ALIEN_SHOTS,
+        GROUP_GOODIES,
+        GROUP_SCENERY,     // Stars and Explosions, which never collide
+        GROUP_SMALLGONS,   // Aliens have one group per kind so each batch is updated without virtual calls
+        GROUP_SMOREGONS,
+        GROUP_SNAGGLEGONS,
+        NUM_GROUPS
+    };
+    
+    struct Spawn
+    {
+        Actor* actor;
+        int    group;
+    };
+    
+    static const int GROUP_LAYERS[NUM_GROUPS];
+    
+    int  tick();
+    void updateStatText();
+    void spawn(Actor* actor, const int& group);
+    void applyCommands();
+    void traceState();
+    
     Blaster* m_blaster;
-    std::list<Actor*> m_actors;
+    std::vector<Actor*> m_groups[NUM_GROUPS];
+    SlotMap             m_slots;   // Where each handle's Actor is in m_groups
+    
+        // Per-tick command buffers
+    std::vector<Spawn>  m_spawns;
+    std::vector<Actor*> m_deaths;
+    
+    std::string m_statText;
+    
+    ActorStats m_actorStats;
+    mutable TickStats m_tickStats; // Queries count themselves even though they don't change the world
+    Autopilot  m_autopilot;
     
     int m_S1, m_S2, m_S3;     // These are their own data members so we don't have to calculate them every tick
     double m_destroyedAliens;
     double m_aliensOnScreen;
 };
 
+// Calls f on every Actor other than the Blaster that can be collided with
+template<typename Func>
+void StudentWorld::forEachCollidable(const Func& f) const
+{
+    for (int group = 0; group < NUM_GROUPS; group++)
+    {
+        if (GROUP_LAYERS[group] == LAYER_NONE)
+            continue;
+        for (const Actor* actor : m_groups[group])
+            f(actor);
+    }
+}
+
 #endif // STUDENTWORLD_H_
@@ -0,0 +1,78 @@
+#ifndef TGAIMAGE_H_
+#define TGAIMAGE_H_
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+  // The decoded contents of an uncompressed TGA file: width*height pixels of
+  // byteCount (3 for BGR, 4 for BGRA) bytes each, bottom row first
+
+struct TGAImage
+{
+	unsigned int			   width;
+	unsigned int			   height;
+	unsigned char			   byteCount;
+	std::vector<unsigned char> data;
+};
+
+inline bool readTGA(const std::string& filename, TGAImage& image)
+{
+	std::ifstream tgaFile(filename, std::ios::in|std::ios::binary);
+
+	if (!tgaFile)
+		return false;
+
+	char type[3];
+	char info[6];
+
+	  // Read file header info
+	tgaFile.read(type, 3);
+	tgaFile.seekg(12);
+	tgaFile.read(info, 6);
+	image.width = static_cast<unsigned char>(info[0]) + static_cast<unsigned char>(info[1]) * 256;
+	image.height = static_cast<unsigned char>(info[2]) + static_cast<unsigned char>(info[3]) * 256;
+	image.byteCount = static_cast<unsigned char>(info[4]) / 8;
+
+	  //image type either 2 (color) or 3 (greyscale)
+	if (!tgaFile || type[1] != 0 || (type[2] != 2 && type[2] != 3))
+		return false;
+
+	if (image.byteCount != 3 && image.byteCount != 4)
+		return false;
+
+	  // Read image data
+	image.data.resize(static_cast<size_t>(image.width) * image.height * image.byteCount);
+	tgaFile.seekg(18);
+	tgaFile.read(reinterpret_cast<char*>(image.data.data()), static_cast<std::streamsize>(image.data.size()));
+	return static_cast<bool>(tgaFile);
+}
+
+  // Writes an uncompressed 32-bit TGA (the same format as the sprite
+  // assets).  pixels holds width*height BGRA pixels, bottom row first, which
+  // is what glReadPixels returns for GL_BGRA.
+
+inline bool writeTGA(const std::string& filename, int width, int height,
+					 const std::vector<unsigned char>& pixels)
+{
+	if (width <= 0 || height <= 0 || pixels.size() < static_cast<size_t>(width) * height * 4)
+		return false;
+
+	std::ofstream tgaFile(filename, std::ios::out|std::ios::binary);
+	if (!tgaFile)
+		return false;
+
+	unsigned char header[18] = { 0 };
+	header[2] = 2;	// uncompressed true-color
+	header[12] = static_cast<unsigned char>(width % 256);
+	header[13] = static_cast<unsigned char>(width / 256);
+	header[14] = static_cast<unsigned char>(height % 256);
+	header[15] = static_cast<unsigned char>(height / 256);
+	header[16] = 32;
+	header[17] = 8;	// 8 bits of alpha, origin at the bottom left
+	tgaFile.write(reinterpret_cast<const char*>(header), sizeof(header));
+	tgaFile.write(reinterpret_cast<const char*>(pixels.data()), static_cast<std::streamsize>(width) * height * 4);
+	return static_cast<bool>(tgaFile);
+}
+
+#endif // TGAIMAGE_H_
@@ -0,0 +1,90 @@
+#ifndef UPSCALEDTARGET_H_
+#define UPSCALEDTARGET_H_
+
+#include "freeglut.h"
+#include "Framebuffer.h"
+#include <algorithm>
+
+  // Draws at a fixed, low resolution and then scales the result up to the
+  // window by the largest whole number that fits, centered, so every drawn
+  // pixel becomes an exact square block of the window's.  Filling and
+  // blending sprites then costs the same however big the window is; the
+  // scaling up is one quad.
+  //
+  // The projection should have the same aspect ratio as the target, since
+  // sprites are drawn into the target through it unchanged.
+
+class UpscaledTarget
+{
+public:
+	  // From now on, draw into a width x height target (cleared to black)
+	  // instead of the window.  Returns false, changing nothing, if there's
+	  // no target to draw into (see Framebuffer.h).
+	bool begin(int width, int height)
+	{
+		if (width != m_target.getWidth()  ||  height != m_target.getHeight())
+		{
+			if (!m_target.resize(width, height, GL_NEAREST, GL_CLAMP))
+				return false;
+		}
+
+		glGetIntegerv(GL_VIEWPORT, m_windowViewport);
+		m_target.bind();
+		glViewport(0, 0, width, height);
+		glClear(GL_COLOR_BUFFER_BIT);
+		return true;
+	}
+
+	  // Goes back to drawing into the window, and fills it with the scaled
+	  // up target, bordered in black
+	void end()
+	{
+		m_target.unbind();
+		glViewport(m_windowViewport[0], m_windowViewport[1], m_windowViewport[2], m_windowViewport[3]);
+
+		int width = m_target.getWidth();
+		int height = m_target.getHeight();
+		int scale = std::min(m_windowViewport[2] / width, m_windowViewport[3] / height);
+		if (scale < 1)
+			scale = 1;
+		int left = (m_windowViewport[2] - width * scale) / 2;
+		int bottom = (m_windowViewport[3] - height * scale) / 2;
+
+		glMatrixMode(GL_PROJECTION);
+		glPushMatrix();
+		glLoadIdentity();
+		glOrtho(0, m_windowViewport[2], 0, m_windowViewport[3], -1, 1);
+		glMatrixMode(GL_MODELVIEW);
+		glPushMatrix();
+		glLoadIdentity();
+		glPushAttrib(GL_COLOR_BUFFER_BIT | GL_ENABLE_BIT | GL_TEXTURE_BIT | GL_CURRENT_BIT);
+
+		glDisable(GL_DEPTH_TEST);
+		glDisable(GL_BLEND);
+		glEnable(GL_TEXTURE_2D);
+		glBindTexture(GL_TEXTURE_2D, m_target.getTexture());
+		glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+		glBegin(GL_QUADS);
+		glTexCoord2d(0, 0);
+		glVertex2i(left, bottom);
+		glTexCoord2d(1, 0);
+		glVertex2i(left + width * scale, bottom);
+		glTexCoord2d(1, 1);
+		glVertex2i(left + width * scale, bottom + height * scale);
+		glTexCoord2d(0, 1);
+		glVertex2i(left, bottom + height * scale);
+		glEnd();
+
+		glPopAttrib();
+		glMatrixMode(GL_PROJECTION);
+		glPopMatrix();
+		glMatrixMode(GL_MODELVIEW);
+		glPopMatrix();
+	}
+
+private:
+	Framebuffer m_target;
+	GLint		m_windowViewport[4];
+};
+
+#endif // UPSCALEDTARGET_H_
@@ -0,0 +1,87 @@
+#include "WorldTrace.h"
+#include <algorithm>
+#include <cstdio>
+using namespace std;
+
+  // 64-bit FNV-1a
+
+static const uint64_t HASH_SEED	 = 14695981039346656037ULL;
+static const uint64_t HASH_PRIME = 1099511628211ULL;
+
+static uint64_t hashBytes(uint64_t hash, const char* bytes, size_t length)
+{
+	for (size_t i = 0; i < length; i++)
+	{
+		hash ^= static_cast<unsigned char>(bytes[i]);
+		hash *= HASH_PRIME;
+	}
+	return hash;
+}
+
+static bool actorLess(const TracedActor& a, const TracedActor& b)
+{
+	if (a.imageID != b.imageID)
+		return a.imageID < b.imageID;
+	if (a.x != b.x)
+		return a.x < b.x;
+	if (a.y != b.y)
+		return a.y < b.y;
+	if (a.direction != b.direction)
+		return a.direction < b.direction;
+	if (a.size != b.size)
+		return a.size < b.size;
+	if (a.health != b.health)
+		return a.health < b.health;
+	if (a.plan != b.plan)
+		return a.plan < b.plan;
+	if (a.dy != b.dy)
+		return a.dy < b.dy;
+	if (a.speed != b.speed)
+		return a.speed < b.speed;
+	if (a.shotBy != b.shotBy)
+		return a.shotBy < b.shotBy;
+	return a.damage < b.damage;
+}
+
+bool WorldTrace::open(const string& filename)
+{
+	m_out.open(filename.c_str());
+	if (!m_out)
+		return false;
+	m_out << WORLD_TRACE_HEADER << '\n';
+	return true;
+}
+
+void WorldTrace::beginTick(const TracedWorld& world)
+{
+	m_world = world;
+	m_actors.clear();
+}
+
+void WorldTrace::endTick()
+{
+	sort(m_actors.begin(), m_actors.end(), actorLess);
+
+	  // %.17g round-trips a double exactly, so even the smallest difference
+	  // in a position shows up
+	char line[512];
+	int length = snprintf(line, sizeof(line), "tick %lu level %u lives %u score %u energy %.17g torpedoes %d destroyed %.17g random %u actors %u",
+						  m_world.tick, m_world.level, m_world.lives, m_world.score, m_world.energy,
+						  m_world.torpedoes, m_world.aliensDestroyed, static_cast<unsigned int>(m_world.random),
+						  static_cast<unsigned int>(m_actors.size()));
+	uint64_t hash = hashBytes(HASH_SEED, line, length);
+	m_out << line;
+
+	m_lines.clear();
+	for (const TracedActor& a : m_actors)
+	{
+		length = snprintf(line, sizeof(line), "  %d %.17g %.17g %d %.17g %.17g %d %d %.17g %d %.17g\n",
+						  a.imageID, a.x, a.y, a.direction, a.size, a.health,
+						  a.plan, a.dy, a.speed, a.shotBy, a.damage);
+		hash = hashBytes(hash, line, length);
+		m_lines.append(line, length);
+	}
+
+	snprintf(line, sizeof(line), " hash %016llx\n", static_cast<unsigned long long>(hash));
+	m_out << line << m_lines;
+}
@@ -0,0 +1,78 @@
+#ifndef WORLDTRACE_H_
+#define WORLDTRACE_H_
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+  // The state of one Actor at the end of a tick
+
+struct TracedActor
+{
+	int	   imageID;
+	double x;
+	double y;
+	int	   direction;
+	double size;
+	double health;	  // 0 for Actors that can't be damaged
+	int	   plan;	  // an Alien's flight plan, direction and speed; 0 for other Actors
+	int	   dy;
+	double speed;
+	int	   shotBy;	  // a projectile's owner (SHOT_BY_PLAYER or SHOT_BY_ALIEN) and damage;
+	double damage;	  // -1 and 0 for other Actors
+};
+
+  // The state of the rest of the world at the end of a tick
+
+struct TracedWorld
+{
+	unsigned long tick;
+	unsigned int  level;
+	unsigned int  lives;
+	unsigned int  score;
+	double		  energy;		  // the Blaster's
+	int			  torpedoes;
+	double		  aliensDestroyed;
+	std::uint32_t random;		  // the next number the random generator would produce
+};
+
+  // A dump of the complete world state after every tick, for checking that
+  // two builds (say, before and after an optimization) play a game exactly
+  // the same way.  Run both with the same --seed and --replay, each with
+  // --trace, and compare the traces with Tools/TraceDiff.
+  //
+  // The file is text: a header line, then for each tick one line with the
+  // TracedWorld fields, the number of Actors and a hash of everything, and
+  // then one line per Actor.  Actors are sorted by their state rather than
+  // listed in storage order, so changing how the world stores or updates
+  // them doesn't change the trace unless it changes the game.
+
+const char* const WORLD_TRACE_HEADER = "NachenBlaster world trace 2";
+
+class WorldTrace
+{
+public:
+	bool open(const std::string& filename);
+
+	bool isOpen() const
+	{
+		return m_out.is_open();
+	}
+
+	  // Call beginTick, then addActor for every Actor, then endTick
+	void beginTick(const TracedWorld& world);
+	void addActor(const TracedActor& actor)
+	{
+		m_actors.push_back(actor);
+	}
+	void endTick();
+
+private:
+	std::ofstream			 m_out;
+	TracedWorld				 m_world;
+	std::vector<TracedActor> m_actors;
+	std::string				 m_lines;	// this tick's Actor lines, kept to reuse the buffer
+};
+
+#endif // WORLDTRACE_H_
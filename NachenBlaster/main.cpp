@@ -1,7 +1,15 @@
 #include "GameController.h"
+#include "GameWorld.h"
+#include "GameConstants.h"
+#include "Options.h"
+#include "BatchEnv.h"
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <cstdlib>
+#include <random>
+#include <chrono>
+#include <vector>
 using namespace std;
 
   // If your program is having trouble finding the Assets directory,
@@ -14,10 +22,63 @@ class GameWorld;
 
 GameWorld* createStudentWorld(string assetDir = "");
 
+  // Steps a BatchEnv with random actions as fast as it can, and reports how
+  // many world steps per second it managed
+
+static int runBatch(const Options& options)
+{
+	unsigned int seed = options.seeded ? options.seed : random_device()();
+	BatchEnv env(options.batchWorlds, options.threads);
+	if (options.gridWidth > 0)
+		env.setGridSize(options.gridWidth, options.gridHeight);
+	env.reset(seed);
+
+	mt19937 random(seed);
+	uniform_int_distribution<int> pickAction(0, NUM_ACTIONS - 1);
+	vector<int> actions(options.batchWorlds);
+	double totalReward = 0;
+	auto start = chrono::steady_clock::now();
+	for (int k = 0; k < options.headlessTicks; k++)
+	{
+		for (int& action : actions)
+			action = pickAction(random);
+		env.step(actions.data());
+		for (int w = 0; w < options.batchWorlds; w++)
+			totalReward += env.rewards()[w];
+	}
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	double steps = static_cast<double>(options.headlessTicks) * options.batchWorlds;
+	cout << "Batch: " << options.batchWorlds << " worlds x " << options.headlessTicks << " steps, seed " << seed;
+	if (options.gridWidth > 0)
+		cout << ", " << options.gridWidth << "x" << options.gridHeight << " grids";
+	cout << endl
+		 << "  " << (seconds > 0 ? steps / seconds : 0) << " steps/s, "
+		 << env.episodesFinished() << " episodes finished, total reward " << totalReward << endl;
+	return 0;
+}
+
 int main(int argc, char* argv[])
 {
+	Options options;
+	options.assetDirectory = assetDirectory;
+	string error;
+	if (!parseOptions(argc, argv, options, error))
+	{
+		cout << error << endl;
+		printUsage(cout, argv[0]);
+		return 1;
+	}
+	if (options.help)
+	{
+		printUsage(cout, argv[0]);
+		return 0;
+	}
+	if (options.batchWorlds > 0)
+		return runBatch(options);
+
 	{
-		string path = assetDirectory;
+		string path = options.assetDirectory;
 		if (!path.empty())
 			path += '/';
 		const string someAsset = "ship.tga";
@@ -25,11 +86,49 @@ int main(int argc, char* argv[])
 		if (!ifs)
 		{
 			cout << "Cannot find " << someAsset << " in ";
-			cout << (assetDirectory.empty() ? "current directory" : assetDirectory) << endl;
+			cout << (options.assetDirectory.empty() ? "current directory" : options.assetDirectory) << endl;
 			return 1;
 		}
 	}
 
-	GameWorld* gw = createStudentWorld(assetDirectory);
+	GameWorld* gw = createStudentWorld(options.assetDirectory);
+	if (!options.eventLog.empty()  &&  !gw->openEventLog(options.eventLog))
+	{
+		cout << "Cannot open " << options.eventLog << endl;
+		return 1;
+	}
+	if (!options.traceFile.empty()  &&  !gw->openTrace(options.traceFile))
+	{
+		cout << "Cannot open " << options.traceFile << endl;
+		return 1;
+	}
+
+	  // A replay has to use the seed it was recorded with, and the recorded
+	  // keys already include whatever the autopilot pressed
+	if (!options.replayFile.empty())
+	{
+		if (!gw->startPlayback(options.replayFile, options.seed))
+		{
+			cout << "Cannot replay " << options.replayFile << endl;
+			return 1;
+		}
+		options.seeded = true;
+		options.autopilot = false;
+	}
+	if (!options.seeded)
+		options.seed = random_device()();
+	seedRandom(options.seed);
+	if (!options.recordFile.empty()  &&  !gw->startRecording(options.recordFile, options.seed))
+	{
+		cout << "Cannot write " << options.recordFile << endl;
+		return 1;
+	}
+	if (!options.watchdogKeys.empty())
+		gw->keepKeyHistory(options.seed);
+	gw->setAutopilot(options.autopilot);
+
+	Game().configure(options);
+	if (options.headless)
+		return Game().runHeadless(gw);
 	Game().run(argc, argv, gw, "NachenBlaster");
 }
@@ -0,0 +1,78 @@
+  // Times Alien updates: 3000 aliens, a third of each kind, moved for 10
+  // ticks in a world with no controller and nothing else in it, best of 20
+  // runs.  Reports the time per alien update both through doSomething(),
+  // one virtual call per alien as StudentWorld used to do it, and through
+  // each kind's updateBatch(), as StudentWorld::move() does now.
+  //
+  //   g++ -std=c++14 -O2 -I../NachenBlaster AlienBench.cpp $(ls ../NachenBlaster/*.cpp | grep -v main.cpp) -lglut -lGLU -lGL -lEGL -lpthread -o AlienBench
+  //   ./AlienBench
+  //
+  // (On macOS, link with -framework OpenGL -framework GLUT instead.)  To see
+  // how a change affects the numbers, build this against the sources before
+  // and after it and compare.
+
+#include "Actor.h"
+#include "StudentWorld.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+using namespace std;
+
+static const int NUM_ALIENS = 3000;
+static const int NUM_TICKS = 10;
+static const int NUM_RUNS = 20;
+
+  // Nanoseconds per alien update, best of NUM_RUNS runs, each in a fresh
+  // world with freshly made aliens
+template<typename Update>
+static double timeUpdates(Update update)
+{
+	double best = 1e30;
+	for (int run = 0; run < NUM_RUNS; run++)
+	{
+		StudentWorld world("");
+		world.init();
+		vector<Actor*> kinds[3];
+		for (int i = 0; i < NUM_ALIENS / 3; i++)
+		{
+			kinds[0].push_back(new Smallgon(&world));
+			kinds[1].push_back(new Smoregon(&world));
+			kinds[2].push_back(new Snagglegon(&world));
+		}
+
+		auto start = chrono::steady_clock::now();
+		for (int tick = 0; tick < NUM_TICKS; tick++)
+			update(kinds);
+		auto stop = chrono::steady_clock::now();
+
+		double ns = chrono::duration<double, nano>(stop - start).count() / (NUM_ALIENS / 3 * 3 * NUM_TICKS);
+		if (ns < best)
+			best = ns;
+		for (const vector<Actor*>& kind : kinds)
+		{
+			for (Actor* a : kind)
+				delete a;
+		}
+	}
+	return best;
+}
+
+int main()
+{
+	double virtualNs = timeUpdates([](vector<Actor*>* kinds) {
+		for (int i = 0; i < NUM_ALIENS / 3; i++)
+		{
+			for (int k = 0; k < 3; k++)
+				kinds[k][i]->doSomething();
+		}
+	});
+	double batchNs = timeUpdates([](vector<Actor*>* kinds) {
+		Smallgon::updateBatch(kinds[0]);
+		Smoregon::updateBatch(kinds[1]);
+		Snagglegon::updateBatch(kinds[2]);
+	});
+
+	printf("doSomething(): %.1f ns per alien update\n", virtualNs);
+	printf("updateBatch(): %.1f ns per alien update\n", batchNs);
+	return 0;
+}
@@ -0,0 +1,148 @@
+  // Summarizes a NachenBlaster event log (written with --event-log=FILE)
+  // level by level.
+  //
+  //   g++ -std=c++14 -I../NachenBlaster EventLogReader.cpp -o EventLogReader
+  //   ./EventLogReader events.bin
+
+#include "EventLog.h"
+#include "GameConstants.h"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <string>
+using namespace std;
+
+static const char* imageName(int imageID)
+{
+	switch (imageID)
+	{
+		case IID_NACHENBLASTER:	 return "NachenBlaster";
+		case IID_SMALLGON:		 return "Smallgon";
+		case IID_SMOREGON:		 return "Smoregon";
+		case IID_SNAGGLEGON:	 return "Snagglegon";
+		case IID_REPAIR_GOODIE:	 return "Repair goodie";
+		case IID_LIFE_GOODIE:	 return "Extra life goodie";
+		case IID_TORPEDO_GOODIE: return "Torpedo goodie";
+		case IID_TORPEDO:		 return "Torpedo";
+		case IID_TURNIP:		 return "Turnip";
+		case IID_CABBAGE:		 return "Cabbage";
+		default:				 return "?";
+	}
+}
+
+struct LevelStats
+{
+	LevelStats()
+	 : attempts(0), finished(0), deaths(0), ticks(0), points(0),
+	   damageTaken(0), damageDealt(0), playerShots(0), alienShots(0)
+	{
+	}
+
+	int attempts;
+	int finished;
+	int deaths;
+	long ticks;
+	long points;
+	long damageTaken;
+	long damageDealt;
+	long playerShots;
+	long alienShots;
+	map<int, int> kills;	// by alien image
+	map<int, int> goodies;	// by goodie image
+	map<int, int> shots;	// by projectile image
+};
+
+static void printCounts(const char* title, const map<int, int>& counts)
+{
+	if (counts.empty())
+		return;
+	cout << "  " << title << ":";
+	for (auto& c : counts)
+		cout << "  " << imageName(c.first) << " " << c.second;
+	cout << endl;
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc != 2)
+	{
+		cout << "Usage: " << argv[0] << " EVENT_LOG" << endl;
+		return 1;
+	}
+	FILE* f = fopen(argv[1], "rb");
+	if (f == nullptr)
+	{
+		cout << "Cannot open " << argv[1] << endl;
+		return 1;
+	}
+
+	GameEventLogHeader header;
+	if (fread(&header, sizeof(header), 1, f) != 1  ||  memcmp(header.magic, "NBEV", 4) != 0)
+	{
+		cout << argv[1] << " is not an event log" << endl;
+		return 1;
+	}
+	if (header.version != EVENT_LOG_VERSION  ||  header.recordSize != sizeof(GameEvent))
+	{
+		cout << argv[1] << " is version " << header.version << " with " << header.recordSize
+			 << "-byte records; this reader handles version " << EVENT_LOG_VERSION << endl;
+		return 1;
+	}
+
+	map<int, LevelStats> levels;
+	long events = 0;
+	unsigned long levelStart = 0;
+	GameEvent e;
+	while (fread(&e, sizeof(e), 1, f) == 1)
+	{
+		events++;
+		LevelStats& s = levels[e.level];
+		switch (e.type)
+		{
+			case EVENT_LEVEL_START:
+				s.attempts++;
+				levelStart = e.tick;
+				break;
+			case EVENT_LEVEL_END:
+				if (e.value == GWSTATUS_FINISHED_LEVEL)
+					s.finished++;
+				else
+					s.deaths++;
+				s.ticks += e.tick - levelStart;
+				break;
+			case EVENT_KILL:
+				s.kills[e.subject]++;
+				s.points += e.value;
+				break;
+			case EVENT_DAMAGE:
+				if (e.subject == IID_NACHENBLASTER)
+					s.damageTaken += e.value;
+				else
+					s.damageDealt += e.value;
+				break;
+			case EVENT_GOODIE:
+				s.goodies[e.subject]++;
+				s.points += e.value;
+				break;
+			case EVENT_SHOT:
+				s.shots[e.subject]++;
+				break;
+		}
+	}
+	fclose(f);
+
+	cout << events << " events" << endl;
+	for (auto& l : levels)
+	{
+		const LevelStats& s = l.second;
+		cout << endl << "Level " << l.first << ": " << s.attempts << " attempts, "
+			 << s.finished << " finished, " << s.deaths << " lives lost, " << s.ticks << " ticks" << endl;
+		cout << "  Points: " << s.points << "  Damage dealt: " << s.damageDealt
+			 << "  Damage taken: " << s.damageTaken << endl;
+		printCounts("Kills", s.kills);
+		printCounts("Goodies", s.goodies);
+		printCounts("Shots", s.shots);
+	}
+}
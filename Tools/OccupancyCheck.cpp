@@ -0,0 +1,151 @@
+  // Checks rasterizeOccupancy() (see OccupancyGrid.h) against the simplest
+  // possible rasterizer: every cell of the grid tested against every Actor,
+  // one at a time, with no clamping and no SIMD.  The worlds are played by
+  // the autopilot for a few games each, and every tick is rasterized at
+  // several grid sizes, including widths that aren't a multiple of four, so
+  // the four-cell row kernel, its scalar tail and the clamping at the edges
+  // of the screen all get exercised.  Also reports the time per grid.
+  //
+  //   g++ -std=c++14 -O2 -I../NachenBlaster OccupancyCheck.cpp $(ls ../NachenBlaster/*.cpp | grep -v main.cpp) -lglut -lGLU -lGL -lEGL -lpthread -o OccupancyCheck
+  //   ./OccupancyCheck
+  //
+  // (On macOS, link with -framework OpenGL -framework GLUT instead.)  Build
+  // it once more with -U__SSE2__ to check the scalar path on its own.
+  //
+  // Exits with 0 if every grid matches the reference, and 1 if any doesn't.
+
+#include "Actor.h"
+#include "GameConstants.h"
+#include "OccupancyGrid.h"
+#include "StudentWorld.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+using namespace std;
+
+static const int NUM_GAMES = 5;
+static const int MAX_TICKS_PER_GAME = 3000;
+
+struct GridSize
+{
+	int width;
+	int height;
+};
+
+static const GridSize GRID_SIZES[] = { { 32, 32 }, { 128, 128 }, { 37, 23 }, { 7, 5 }, { 1, 1 } };
+static const int NUM_GRID_SIZES = sizeof(GRID_SIZES) / sizeof(GRID_SIZES[0]);
+
+  // The channel for a layer, straight from the order of the LAYER_ bits
+static int referenceChannel(int layer)
+{
+	for (int channel = 0; channel < GRID_CHANNELS; channel++)
+	{
+		if (layer == (1 << channel))
+			return channel;
+	}
+	return -1;
+}
+
+static void referenceOccupancy(const StudentWorld& world, int width, int height, float* out)
+{
+	fill(out, out + GRID_CHANNELS * width * height, 0.0f);
+	float cellW = static_cast<float>(VIEW_WIDTH) / width;
+	float cellH = static_cast<float>(VIEW_HEIGHT) / height;
+
+	auto plot = [&](const Actor* a)
+	{
+		int channel = referenceChannel(a->getLayer());
+		if (!a->isAlive()  ||  channel < 0)
+			return;
+		float x = static_cast<float>(a->getX());
+		float y = static_cast<float>(a->getY());
+		float radius = static_cast<float>(a->getRadius());
+		for (int row = 0; row < height; row++)
+		{
+			for (int col = 0; col < width; col++)
+			{
+				  // From the circle's center to the nearest point of the cell
+				float dx = max(fabs((col + 0.5f) * cellW - x) - cellW / 2, 0.0f);
+				float dy = max(fabs((row + 0.5f) * cellH - y) - cellH / 2, 0.0f);
+				if (dx * dx + dy * dy < radius * radius)
+					out[(channel * height + row) * width + col] = 1;
+			}
+		}
+	};
+
+	if (world.getBlaster() != nullptr)
+		plot(world.getBlaster());
+	world.forEachCollidable(plot);
+}
+
+int main()
+{
+	mt19937 generator(1);
+	threadGenerator() = &generator;
+	GraphObject::tracksNewObjects() = false;
+
+	vector<float> grid;
+	vector<float> reference;
+	long grids = 0;
+	long mismatches = 0;
+	double seconds[NUM_GRID_SIZES] = {};
+	long ticks = 0;
+
+	for (int game = 0; game < NUM_GAMES; game++)
+	{
+		StudentWorld world("");
+		world.setAutopilot(true);
+		world.init();
+		for (int tick = 0; tick < MAX_TICKS_PER_GAME; tick++)
+		{
+			int status = world.move();
+			if (status == GWSTATUS_FINISHED_LEVEL)
+				world.advanceToNextLevel();
+			if (status != GWSTATUS_CONTINUE_GAME)
+			{
+				world.cleanUp();
+				if (world.isGameOver())
+					break;
+				world.init();
+			}
+			ticks++;
+
+			for (int k = 0; k < NUM_GRID_SIZES; k++)
+			{
+				int width = GRID_SIZES[k].width;
+				int height = GRID_SIZES[k].height;
+				grid.assign(GRID_CHANNELS * width * height, -1.0f);
+				reference.resize(grid.size());
+
+				auto start = chrono::steady_clock::now();
+				rasterizeOccupancy(world, width, height, grid.data());
+				seconds[k] += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+				referenceOccupancy(world, width, height, reference.data());
+				grids++;
+				for (size_t i = 0; i < grid.size(); i++)
+				{
+					if (grid[i] != reference[i])
+					{
+						if (mismatches == 0)
+						{
+							int cells = width * height;
+							printf("First mismatch: tick %ld, %dx%d grid, channel %d, row %d, column %d: %g, not %g\n",
+								   ticks, width, height, static_cast<int>(i / cells), static_cast<int>(i % cells / width),
+								   static_cast<int>(i % width), grid[i], reference[i]);
+						}
+						mismatches++;
+					}
+				}
+			}
+		}
+	}
+
+	printf("%ld grids over %ld ticks, %ld mismatched cells\n", grids, ticks, mismatches);
+	for (int k = 0; k < NUM_GRID_SIZES; k++)
+		printf("  %dx%d: %.3f us per grid\n", GRID_SIZES[k].width, GRID_SIZES[k].height, seconds[k] / ticks * 1e6);
+	return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,164 @@
+  // Compares two NachenBlaster world traces (written with --trace=FILE) and
+  // reports the first tick where they differ, and the first Actor that
+  // differs on that tick.  To check that a change doesn't change gameplay,
+  // record a game with the old build, replay it with both, and compare:
+  //
+  //   g++ -std=c++14 -I../NachenBlaster TraceDiff.cpp -o TraceDiff
+  //   ./old --headless=5000 --autopilot --seed=1 --record=game.keys
+  //   ./old --headless=5000 --replay=game.keys --trace=old.trace
+  //   ./new --headless=5000 --replay=game.keys --trace=new.trace
+  //   ./TraceDiff old.trace new.trace
+  //
+  // Exits with 0 if the traces match, 1 if they don't, and 2 on bad input.
+
+#include "WorldTrace.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+using namespace std;
+
+  // One tick of a trace: the world line, and the Actor lines under it
+
+struct TraceTick
+{
+	string		   world;
+	vector<string> actors;
+};
+
+class TraceReader
+{
+public:
+	TraceReader(const char* filename)
+	 : m_filename(filename), m_in(filename)
+	{
+	}
+
+	bool readHeader()
+	{
+		string header;
+		if (!getline(m_in, header)  ||  header != WORLD_TRACE_HEADER)
+		{
+			cerr << m_filename << " is not a world trace" << endl;
+			return false;
+		}
+		return true;
+	}
+
+	  // Returns false at the end of the trace
+	bool next(TraceTick& tick)
+	{
+		if (!getline(m_in, tick.world))
+			return false;
+		tick.actors.clear();
+		int count = actorCount(tick.world);
+		string line;
+		for (int i = 0; i < count  &&  getline(m_in, line); i++)
+			tick.actors.push_back(line);
+		return true;
+	}
+
+	const string& filename() const
+	{
+		return m_filename;
+	}
+
+private:
+	string	 m_filename;
+	ifstream m_in;
+
+	static int actorCount(const string& world)
+	{
+		istringstream in(world);
+		string word;
+		int count = 0;
+		while (in >> word)
+		{
+			if (word == "actors")
+			{
+				in >> count;
+				break;
+			}
+		}
+		return count;
+	}
+};
+
+  // The world line without its hash, which differs whenever anything does
+static string withoutHash(const string& world)
+{
+	return world.substr(0, world.find(" hash "));
+}
+
+static void report(const TraceReader& a, const TraceTick& ta, const TraceReader& b, const TraceTick& tb)
+{
+	cout << "Traces diverge:" << endl
+		 << "  " << a.filename() << ": " << withoutHash(ta.world) << endl
+		 << "  " << b.filename() << ": " << withoutHash(tb.world) << endl;
+
+	  // Actor lines are sorted by state, so the first mismatch is the first
+	  // Actor (by image, then position) that's different
+	size_t n = min(ta.actors.size(), tb.actors.size());
+	for (size_t i = 0; i < n; i++)
+	{
+		if (ta.actors[i] != tb.actors[i])
+		{
+			cout << "First differing actor (image x y direction size health plan dy speed shotBy damage):" << endl
+				 << "  " << a.filename() << ":" << ta.actors[i] << endl
+				 << "  " << b.filename() << ":" << tb.actors[i] << endl;
+			return;
+		}
+	}
+	if (ta.actors.size() != tb.actors.size())
+	{
+		const TraceTick& longer = ta.actors.size() > n ? ta : tb;
+		const TraceReader& name = ta.actors.size() > n ? a : b;
+		cout << "Only in " << name.filename() << ":" << longer.actors[n] << endl;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc != 3)
+	{
+		cerr << "Usage: " << argv[0] << " reference.trace candidate.trace" << endl;
+		return 2;
+	}
+
+	TraceReader a(argv[1]);
+	TraceReader b(argv[2]);
+	if (!a.readHeader()  ||  !b.readHeader())
+		return 2;
+
+	TraceTick ta;
+	TraceTick tb;
+	long ticks = 0;
+	for (;;)
+	{
+		bool moreA = a.next(ta);
+		bool moreB = b.next(tb);
+		if (!moreA  ||  !moreB)
+		{
+			if (moreA != moreB)
+			{
+				cout << (moreA ? b : a).filename() << " ends after " << ticks << " ticks" << endl;
+				return 1;
+			}
+			break;
+		}
+
+		  // The world line ends with a hash of the whole tick, so it's all
+		  // that needs comparing until something differs
+		if (ta.world != tb.world)
+		{
+			report(a, ta, b, tb);
+			return 1;
+		}
+		ticks++;
+	}
+
+	cout << ticks << " ticks match" << endl;
+	return 0;
+}